@@ -0,0 +1,374 @@
+/** @file allocator_bench.cpp
+ * Allocator microbenchmarks, run through `meson test --benchmark`
+ *
+ * Measures throughput and per-operation latency percentiles of the
+ * allocators in `src/memory/` against the system `malloc`. Preload a
+ * different allocator, i.e. `LD_PRELOAD=libjemalloc.so`, to compare against
+ * it instead. The first argument scales the amount of iterations.
+ */
+
+// module includes
+#include "memory/affix_allocator.cpp"
+#include "memory/cascading_allocator.cpp"
+#include "memory/fallback_allocator.cpp"
+#include "memory/free_list.cpp"
+#include "memory/stack_allocator.cpp"
+#include "memory/thread_caching_allocator.cpp"
+#include "util/util.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// logging
+#include "fmt/format.h"
+
+namespace bench
+{
+    using clock = std::chrono::steady_clock;
+
+    // ============================================================================================== //
+    // Baselines and adapters ======================================================================= //
+    // ============================================================================================== //
+
+    /** System allocator, or whatever is preloaded in its place */
+    class Malloc: private NonCopyable
+    {
+    public:
+        auto alloc(usize size) -> memory::Block
+        {
+            return (memory::Block { std::malloc(size), size });
+        }
+
+        auto owns(memory::Block & /*block*/) const noexcept -> bool
+        {
+            return (true);
+        }
+
+        auto free(memory::Block &block) -> void
+        {
+            std::free(block.addr);
+            block = memory::null_block;
+        }
+    };
+
+    /** Serializes a single-threaded allocator for the cross-thread pattern */
+    template <IsAllocator Allocator>
+    class Locked: private NonCopyable
+    {
+    private:
+        Allocator m_allocator {};
+        mutable std::mutex m_lock {};
+
+    public:
+        auto alloc(usize size) -> memory::Block
+        {
+            std::lock_guard<std::mutex> lock { m_lock };
+            return (m_allocator.alloc(size));
+        }
+
+        auto owns(memory::Block &block) const noexcept -> bool
+        {
+            std::lock_guard<std::mutex> lock { m_lock };
+            return (m_allocator.owns(block));
+        }
+
+        auto free(memory::Block &block) -> void
+        {
+            std::lock_guard<std::mutex> lock { m_lock };
+            m_allocator.free(block);
+        }
+    };
+
+    // ============================================================================================== //
+    // Measurements ================================================================================= //
+    // ============================================================================================== //
+
+    /** Timings of a single run */
+    struct Result
+    {
+        usize ops;
+        f64 seconds;
+        std::vector<f64> latencies;
+    };
+
+    /** Cost of taking two timestamps, subtracted from every latency */
+    auto overhead() -> f64
+    {
+        f64 static const value = [] {
+            auto best = std::chrono::nanoseconds::max();
+
+            for (auto i = 0; i < 10000; ++i) {
+                auto start = clock::now();
+                auto stop  = clock::now();
+
+                best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start));
+            }
+
+            return (static_cast<f64>(best.count()));
+        }();
+
+        return (value);
+    }
+
+    /** Times `op` and records its latency in nanoseconds */
+    template <class F>
+    auto inline timed(Result &result, F &&op) -> void
+    {
+        auto start = clock::now();
+        op();
+        auto stop = clock::now();
+
+        auto elapsed = static_cast<f64>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+        result.latencies.push_back(std::max(0.0, elapsed - overhead()));
+        result.ops += 1U;
+    }
+
+    auto percentile(std::vector<f64> &sorted, f64 rank) -> f64
+    {
+        if (sorted.empty()) {
+            return (0.0);
+        }
+
+        auto index = static_cast<usize>(rank * static_cast<f64>(sorted.size() - 1U));
+        return (sorted[index]);
+    }
+
+    auto report(std::string_view allocator, std::string_view pattern, Result &result) -> void
+    {
+        std::sort(result.latencies.begin(), result.latencies.end());
+
+        auto throughput = (result.seconds > 0.0) ? (static_cast<f64>(result.ops) / result.seconds / 1e6) : 0.0;
+
+        fmt::print("{:<24} {:<18} {:>10} {:>10.2f} {:>8.0f} {:>8.0f} {:>8.0f}\n", allocator, pattern, result.ops,
+                   throughput, percentile(result.latencies, 0.5), percentile(result.latencies, 0.99),
+                   percentile(result.latencies, 0.999));
+        std::fflush(stdout);
+    }
+
+    // ============================================================================================== //
+    // Patterns ===================================================================================== //
+    // ============================================================================================== //
+
+    /** Allocates `count` blocks of `size` bytes and frees them in reverse */
+    template <IsAllocator Allocator>
+    auto lifo(Allocator &allocator, usize rounds, usize count, usize size) -> Result
+    {
+        Result result { 0U, 0.0, {} };
+        result.latencies.reserve(rounds * count * 2U);
+
+        std::vector<memory::Block> blocks(count);
+        auto start = clock::now();
+
+        for (auto round = 0U; round < rounds; ++round) {
+            for (auto &block : blocks) {
+                timed(result, [&] { block = allocator.alloc(size); });
+            }
+
+            for (auto it = blocks.rbegin(); it != blocks.rend(); ++it) {
+                timed(result, [&] { allocator.free(*it); });
+            }
+        }
+
+        result.seconds = std::chrono::duration<f64>(clock::now() - start).count();
+        return (result);
+    }
+
+    /** Allocates `count` blocks of `size` bytes and frees them in random order */
+    template <IsAllocator Allocator>
+    auto random_order(Allocator &allocator, usize rounds, usize count, usize size) -> Result
+    {
+        Result result { 0U, 0.0, {} };
+        result.latencies.reserve(rounds * count * 2U);
+
+        std::vector<memory::Block> blocks(count);
+        std::vector<usize> order(count);
+        std::iota(order.begin(), order.end(), 0U);
+
+        std::mt19937_64 rng { 42U };
+        auto start = clock::now();
+
+        for (auto round = 0U; round < rounds; ++round) {
+            std::shuffle(order.begin(), order.end(), rng);
+
+            for (auto &block : blocks) {
+                timed(result, [&] { block = allocator.alloc(size); });
+            }
+
+            for (auto index : order) {
+                timed(result, [&] { allocator.free(blocks[index]); });
+            }
+        }
+
+        result.seconds = std::chrono::duration<f64>(clock::now() - start).count();
+        return (result);
+    }
+
+    /** Random alloc and free over a working set, sizes skewed towards small blocks */
+    template <IsAllocator Allocator>
+    auto mixed(Allocator &allocator, usize ops, usize slots, usize max_size) -> Result
+    {
+        Result result { 0U, 0.0, {} };
+        result.latencies.reserve(ops);
+
+        std::vector<memory::Block> blocks(slots, memory::null_block);
+
+        std::mt19937_64 rng { 42U };
+        std::uniform_int_distribution<usize> pick { 0U, slots - 1U };
+        std::geometric_distribution<usize> shift { 0.35 };
+
+        auto start = clock::now();
+
+        for (auto i = 0U; i < ops; ++i) {
+            auto &block = blocks[pick(rng)];
+
+            if (block.addr != nullptr) {
+                timed(result, [&] { allocator.free(block); });
+
+                // allocators may keep blocks they cannot reclaim out of order untouched
+                block = memory::null_block;
+            } else {
+                auto size = std::min(max_size, usize { 8U } << std::min(shift(rng), usize { 10U }));
+                timed(result, [&] { block = allocator.alloc(size); });
+            }
+        }
+
+        result.seconds = std::chrono::duration<f64>(clock::now() - start).count();
+
+        for (auto &block : blocks) {
+            if (block.addr != nullptr) {
+                allocator.free(block);
+            }
+        }
+
+        return (result);
+    }
+
+    /** One thread allocates, another one frees, handing blocks over a bounded ring */
+    template <IsAllocator Allocator>
+    auto producer_consumer(Allocator &allocator, usize ops, usize size) -> Result
+    {
+        usize static constexpr const ring_size { 1024U };
+
+        std::vector<memory::Block> ring(ring_size);
+        std::atomic<usize> head { 0U };
+        std::atomic<usize> tail { 0U };
+
+        Result produced { 0U, 0.0, {} };
+        Result consumed { 0U, 0.0, {} };
+        produced.latencies.reserve(ops);
+        consumed.latencies.reserve(ops);
+
+        auto start = clock::now();
+
+        std::thread consumer { [&] {
+            for (auto i = 0U; i < ops; ++i) {
+                while (tail.load(std::memory_order_acquire) == i) {
+                    std::this_thread::yield();
+                }
+
+                auto &block = ring[i % ring_size];
+                timed(consumed, [&] { allocator.free(block); });
+                head.store(i + 1U, std::memory_order_release);
+            }
+        } };
+
+        for (auto i = 0U; i < ops; ++i) {
+            while ((i - head.load(std::memory_order_acquire)) >= ring_size) {
+                std::this_thread::yield();
+            }
+
+            auto &block = ring[i % ring_size];
+            timed(produced, [&] { block = allocator.alloc(size); });
+            tail.store(i + 1U, std::memory_order_release);
+        }
+
+        consumer.join();
+
+        produced.seconds = std::chrono::duration<f64>(clock::now() - start).count();
+        produced.ops += consumed.ops;
+        produced.latencies.insert(produced.latencies.end(), consumed.latencies.begin(), consumed.latencies.end());
+
+        return (produced);
+    }
+
+    // ============================================================================================== //
+    // Suites ======================================================================================= //
+    // ============================================================================================== //
+
+    usize static constexpr const SMALL = { 64U };
+
+    using StackType      = memory::StackAllocator<usize { 1U } << 20U, memory::WORD_ALIGN>;
+    using FreeListType   = memory::FreeList<Malloc, 64U, 1U, SMALL, usize { 1U } << 24U>;
+    using FallbackType   = memory::FallbackAllocator<memory::StackAllocator<usize { 1U } << 16U, memory::WORD_ALIGN>, Malloc>;
+    using CascadingType  = memory::CascadingAllocator<memory::StackAllocator<usize { 1U } << 16U, memory::WORD_ALIGN>>;
+    using AffixType      = memory::AffixAllocator<Malloc, u64, u64>;
+    using ThreadCachType = memory::ThreadCachingAllocator<FreeListType>;
+
+    /** Runs the single-threaded patterns, on the heap as large allocators do not fit the stack */
+    template <IsAllocator Allocator>
+    auto single_threaded(std::string_view name, usize scale, bool reclaims_any_order, usize max_size) -> void
+    {
+        {
+            auto allocator = CreateScope<Allocator>();
+            auto result    = lifo(*allocator, 100U * scale, 1000U, SMALL);
+            report(name, "lifo", result);
+        }
+
+        // allocators freeing only their topmost block would run dry
+        if (!reclaims_any_order) {
+            return;
+        }
+
+        {
+            auto allocator = CreateScope<Allocator>();
+            auto result    = random_order(*allocator, 100U * scale, 1000U, SMALL);
+            report(name, "random", result);
+        }
+
+        {
+            auto allocator = CreateScope<Allocator>();
+            auto result    = mixed(*allocator, 100000U * scale, 1000U, max_size);
+            report(name, "mixed", result);
+        }
+    }
+
+    /** Runs the cross-thread pattern */
+    template <IsAllocator Allocator>
+    auto cross_thread(std::string_view name, usize scale) -> void
+    {
+        auto allocator = CreateScope<Allocator>();
+        auto result    = producer_consumer(*allocator, 100000U * scale, SMALL);
+        report(name, "producer/consumer", result);
+    }
+}  // namespace bench
+
+auto main(int argc, char **argv) -> int
+{
+    auto scale = (argc > 1) ? std::max(1UL, std::strtoul(argv[1], nullptr, 10)) : 1UL;
+
+    fmt::print("{:<24} {:<18} {:>10} {:>10} {:>8} {:>8} {:>8}\n", "allocator", "pattern", "ops", "Mops/s",
+               "p50 ns", "p99 ns", "p999 ns");
+
+    bench::single_threaded<bench::Malloc>("malloc", scale, true, 8192U);
+    bench::single_threaded<bench::StackType>("StackAllocator", scale, false, bench::SMALL);
+    bench::single_threaded<bench::FreeListType>("FreeList", scale, true, bench::SMALL);
+    bench::single_threaded<bench::FallbackType>("FallbackAllocator", scale, true, 8192U);
+    bench::single_threaded<bench::CascadingType>("CascadingAllocator", scale, true, 8192U);
+    bench::single_threaded<bench::AffixType>("AffixAllocator", scale, true, 8192U);
+
+    bench::cross_thread<bench::Malloc>("malloc", scale);
+    bench::cross_thread<bench::Locked<bench::FreeListType>>("Locked<FreeList>", scale);
+    bench::cross_thread<bench::ThreadCachType>("ThreadCachingAllocator", scale);
+
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,436 @@
+/** @file asset_manager.cpp */
+
+// module includes
+#include "asset_manager.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+// logging
+#include "spdlog/spdlog.h"
+
+
+namespace assets
+{
+    ResidencyEvent::ResidencyEvent(ResidencyChange change)
+      : event::Event { (change.residency == Residency::Evicted) ? event::EventType::FreeResource
+                                                                : event::EventType::LoadResource },
+        m_change { std::move(change) }
+    {
+    }
+
+    auto ResidencyEvent::change() const noexcept -> ResidencyChange const &
+    {
+        return (m_change);
+    }
+
+    auto AssetManager::Ticket::operator<(Ticket const &rhs) const noexcept -> bool
+    {
+        if (priority != rhs.priority) {
+            return (priority > rhs.priority);
+        }
+
+        if (deadline != rhs.deadline) {
+            return (deadline < rhs.deadline);
+        }
+
+        return (sequence < rhs.sequence);
+    }
+
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    AssetManager::AssetManager(memory::AllocatorInterface &allocator, usize budget, usize threads)
+      : m_files { CreateScope<FileSource>() }, m_source { *m_files }, m_allocator { allocator }, m_budget { budget }
+    {
+        this->start(threads);
+    }
+
+    AssetManager::AssetManager(AssetSource &source, memory::AllocatorInterface &allocator, usize budget,
+                               usize threads)
+      : m_source { source }, m_allocator { allocator }, m_budget { budget }
+    {
+        this->start(threads);
+    }
+
+    AssetManager::~AssetManager()
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_lock };
+            m_stopping = true;
+        }
+
+        m_ready.notify_all();
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    // ============================================================================================== //
+    // Streaming ==================================================================================== //
+    // ============================================================================================== //
+
+    auto AssetManager::start(usize threads) -> void
+    {
+        if (threads == 0U) {
+            spdlog::error(fmt::format("IO/ERROR: Asset manager needs at least one worker"));
+            throw std::runtime_error("Invalid amount of asset workers");
+        }
+
+        m_workers.reserve(threads);
+
+        for (auto i = usize { 0U }; i < threads; ++i) {
+            m_workers.emplace_back([this] { this->worker(); });
+        }
+    }
+
+    auto AssetManager::worker() -> void
+    {
+        while (true) {
+            std::unique_lock<std::mutex> lock { m_lock };
+            m_ready.wait(lock, [this] { return (m_stopping || !m_queue.empty()); });
+
+            if (m_stopping) {
+                return;
+            }
+
+            auto id = m_queue.begin()->id;
+            m_queue.erase(m_queue.begin());
+
+            // loading entries cannot be released, the path outlives the load
+            auto &entry     = m_entries.at(id);
+            entry.residency = Residency::Loading;
+            lock.unlock();
+
+            this->load(id, entry.path);
+        }
+    }
+
+    auto AssetManager::load(AssetId id, std::string const &path) -> void
+    {
+        auto fail = [&](std::string_view reason) -> void {
+            spdlog::error(fmt::format("IO/ERROR: Asset \'{}\' {}", path, reason));
+
+            std::lock_guard<std::mutex> lock { m_lock };
+            auto &entry = m_entries.at(id);
+
+            m_used -= entry.size;
+            entry.size      = 0U;
+            entry.residency = Residency::Failed;
+            m_changes.push_back(ResidencyChange { id, path, Residency::Failed });
+
+            if (entry.stale) {
+                this->requeue(id, entry);
+            }
+        };
+
+        auto found = std::optional<usize> {};
+        try {
+            found = m_source.size(path);
+        } catch (std::exception const &error) {
+            spdlog::error(fmt::format("IO/ERROR: {}", error.what()));
+        }
+
+        if (!found) {
+            fail("cannot be read");
+            return;
+        }
+
+        auto size = *found;
+
+        {
+            std::lock_guard<std::mutex> lock { m_lock };
+
+            if (!this->make_room(size)) {
+                auto &entry = m_entries.at(id);
+
+                m_changes.push_back(ResidencyChange { id, path, Residency::Failed });
+                entry.residency = Residency::Failed;
+
+                spdlog::error(fmt::format("IO/ERROR: Asset \'{}\' does not fit the budget", path));
+
+                if (entry.stale) {
+                    this->requeue(id, entry);
+                }
+                return;
+            }
+
+            m_used += size;
+            m_entries.at(id).size = size;
+        }
+
+        auto data = memory::SharedBuffer::allocate(m_allocator, size);
+        if (!data) {
+            fail("cannot be allocated");
+            return;
+        }
+
+        auto read = false;
+        try {
+            read = m_source.read(path, data.view());
+        } catch (std::exception const &error) {
+            spdlog::error(fmt::format("IO/ERROR: {}", error.what()));
+        }
+
+        if (!read) {
+            fail("cannot be read");
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock { m_lock };
+        auto &entry = m_entries.at(id);
+
+        m_lru.push_front(id);
+        entry.lru       = m_lru.begin();
+        entry.data      = std::move(data);
+        entry.residency = Residency::Resident;
+        m_changes.push_back(ResidencyChange { id, path, Residency::Resident });
+
+        if (entry.stale) {
+            this->requeue(id, entry);
+        }
+    }
+
+    auto AssetManager::charged() const noexcept -> usize
+    {
+        return (m_used + m_retired->load(std::memory_order_acquire));
+    }
+
+    auto AssetManager::make_room(usize size) -> bool
+    {
+        auto it = m_lru.end();
+
+        while ((it != m_lru.begin()) && ((this->charged() + size) > m_budget)) {
+            auto victim = std::prev(it);
+            auto entry  = m_entries.find(*victim);
+
+            // the manager holds the last reference of unpinned assets
+            if (entry->second.data.use_count() > 1U) {
+                it = victim;
+                continue;
+            }
+
+            this->evict(entry);
+        }
+
+        return ((this->charged() + size) <= m_budget);
+    }
+
+    auto AssetManager::evict(std::unordered_map<AssetId, Entry>::iterator entry) -> void
+    {
+        m_used -= entry->second.size;
+        m_lru.erase(entry->second.lru);
+        m_changes.push_back(ResidencyChange { entry->first, std::move(entry->second.path), Residency::Evicted });
+
+        m_entries.erase(entry);
+    }
+
+    auto AssetManager::enqueue(AssetId id, Entry &entry, Priority priority, Clock::time_point deadline) -> void
+    {
+        entry.residency = Residency::Queued;
+        entry.ticket    = Ticket { priority, deadline, m_sequence++, id };
+
+        m_queue.insert(entry.ticket);
+        m_ready.notify_one();
+    }
+
+    auto AssetManager::requeue(AssetId id, Entry &entry) -> void
+    {
+        if (entry.residency == Residency::Resident) {
+            m_used -= entry.size;
+            m_lru.erase(entry.lru);
+
+            // pinned data stays charged until its last holder lets go
+            if (entry.data.use_count() > 1U) {
+                auto *owner = new std::shared_ptr<std::atomic<usize>> { m_retired };
+                auto hook   = [](void *context, usize length) noexcept -> void {
+                    auto *retired = static_cast<std::shared_ptr<std::atomic<usize>> *>(context);
+
+                    (*retired)->fetch_sub(length, std::memory_order_acq_rel);
+                    delete retired;
+                };
+
+                if (entry.data.on_release(hook, owner)) {
+                    m_retired->fetch_add(entry.size, std::memory_order_acq_rel);
+                } else {
+                    delete owner;
+                }
+            }
+        }
+
+        entry.size  = 0U;
+        entry.data  = memory::SharedBuffer {};
+        entry.stale = false;
+
+        this->enqueue(id, entry, entry.ticket.priority, Clock::time_point::max());
+    }
+
+    // ============================================================================================== //
+    // AssetManager implementation ================================================================== //
+    // ============================================================================================== //
+
+    auto AssetManager::request(std::string_view path, Priority priority, Clock::time_point deadline) -> AssetId
+    {
+        auto id = static_cast<AssetId>(util::string::hash_str(path));
+
+        std::lock_guard<std::mutex> lock { m_lock };
+
+        auto [it, inserted] = m_entries.try_emplace(id);
+        auto &entry         = it->second;
+
+        if (inserted) {
+            entry.path      = path;
+            entry.residency = Residency::None;
+            entry.size      = 0U;
+            entry.stale     = false;
+        } else if (entry.path != path) {
+            spdlog::error(fmt::format("IO/ERROR: Assets \'{}\' and \'{}\' share the same hash", entry.path, path));
+            throw std::runtime_error("Asset hash collision");
+        }
+
+        switch (entry.residency) {
+        case Residency::None:
+        case Residency::Failed: {
+            this->enqueue(id, entry, priority, deadline);
+        } break;
+        case Residency::Queued: {
+            auto sooner = entry.ticket;
+            sooner.priority = std::max(sooner.priority, priority);
+            sooner.deadline = std::min(sooner.deadline, deadline);
+
+            if (sooner < entry.ticket) {
+                m_queue.erase(entry.ticket);
+                m_queue.insert(sooner);
+                entry.ticket = sooner;
+            }
+        } break;
+        case Residency::Resident: {
+            m_lru.splice(m_lru.begin(), m_lru, entry.lru);
+        } break;
+        default: {
+        } break;
+        }
+
+        return (id);
+    }
+
+    auto AssetManager::get(AssetId id) -> memory::SharedBuffer
+    {
+        std::lock_guard<std::mutex> lock { m_lock };
+
+        auto it = m_entries.find(id);
+        if ((it == m_entries.end()) || (it->second.residency != Residency::Resident)) {
+            return (memory::SharedBuffer {});
+        }
+
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+        return (it->second.data);
+    }
+
+    auto AssetManager::release(AssetId id) -> bool
+    {
+        std::lock_guard<std::mutex> lock { m_lock };
+
+        auto it = m_entries.find(id);
+        if (it == m_entries.end()) {
+            return (true);
+        }
+
+        switch (it->second.residency) {
+        case Residency::Queued: {
+            m_queue.erase(it->second.ticket);
+            m_entries.erase(it);
+        } break;
+        case Residency::Resident: {
+            if (it->second.data.use_count() > 1U) {
+                return (false);
+            }
+
+            this->evict(it);
+        } break;
+        case Residency::Loading: {
+            return (false);
+        }
+        default: {
+            m_entries.erase(it);
+        } break;
+        }
+
+        return (true);
+    }
+
+    auto AssetManager::reload(std::string_view path) -> bool
+    {
+        auto id = static_cast<AssetId>(util::string::hash_str(path));
+
+        std::lock_guard<std::mutex> lock { m_lock };
+
+        auto it = m_entries.find(id);
+        if ((it == m_entries.end()) || (it->second.path != path)) {
+            return (false);
+        }
+
+        switch (it->second.residency) {
+        case Residency::Loading: {
+            // the file may have been read before it changed
+            it->second.stale = true;
+        } break;
+        case Residency::Resident:
+        case Residency::Failed: {
+            this->requeue(id, it->second);
+        } break;
+        default: {
+        } break;
+        }
+
+        return (true);
+    }
+
+    auto AssetManager::set_budget(usize budget) -> void
+    {
+        std::lock_guard<std::mutex> lock { m_lock };
+
+        m_budget = budget;
+        this->make_room(0U);
+    }
+
+    auto AssetManager::poll(Callback const &callback) -> usize
+    {
+        std::vector<ResidencyChange> changes {};
+        {
+            std::lock_guard<std::mutex> lock { m_lock };
+            changes.swap(m_changes);
+        }
+
+        for (auto const &change : changes) {
+            callback(change);
+        }
+
+        return (changes.size());
+    }
+
+    auto AssetManager::residency(AssetId id) const -> Residency
+    {
+        std::lock_guard<std::mutex> lock { m_lock };
+
+        auto it = m_entries.find(id);
+        return ((it != m_entries.end()) ? it->second.residency : Residency::None);
+    }
+
+    auto AssetManager::budget() const -> usize
+    {
+        std::lock_guard<std::mutex> lock { m_lock };
+        return (m_budget);
+    }
+
+    auto AssetManager::used() const -> usize
+    {
+        std::lock_guard<std::mutex> lock { m_lock };
+        return (this->charged());
+    }
+}  // namespace assets
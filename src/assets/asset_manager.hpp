@@ -0,0 +1,241 @@
+/** @file asset_manager.hpp */
+
+#pragma once
+
+// module includes
+#include "asset_source.hpp"
+#include "event/event.hpp"
+#include "memory/allocator_interface.hpp"
+#include "memory/buffer_ref.hpp"
+#include "util/util.hpp"
+
+// c++ includes
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+namespace assets
+{
+    /** Assets are keyed by the hash of their path */
+    using AssetId = u32;
+
+    /** Order in which queued assets are streamed in */
+    enum class Priority : u8
+    {
+        Background = 0,
+        Normal,
+        High,
+        /** Needed for the next frame */
+        Critical,
+    };
+
+    enum class Residency
+    {
+        /** Never requested, released or evicted */
+        None = 0,
+        Queued,
+        Loading,
+        Resident,
+        /** Unreadable, or larger than what the budget can make room for */
+        Failed,
+        /** Only reported by events, the asset is `None` afterwards */
+        Evicted,
+    };
+
+    /** Residency change of an asset */
+    struct ResidencyChange
+    {
+        AssetId id;
+        std::string path;
+        Residency residency;
+    };
+
+    /**
+     * `LoadResource` event for loaded or failed assets, `FreeResource` for
+     * evicted ones
+     */
+    class ResidencyEvent: public event::Event
+    {
+    private:
+        ResidencyChange m_change;
+
+    public:
+        explicit ResidencyEvent(ResidencyChange change);
+
+        [[nodiscard]] auto change() const noexcept -> ResidencyChange const &;
+    };
+
+    /**
+     * Streams assets in on worker threads within a memory budget
+     *
+     * Requests for an asset already queued, loading or resident share it,
+     * a queued one is only moved up if asked for sooner. Workers take the
+     * highest priority first and the earliest deadline among equals.
+     *
+     * Assets are read through an `AssetSource`, loose files unless another
+     * one is given, e.g. an `ArchiveSource` decompressing archive entries.
+     * They live in `SharedBuffer`s from `allocator`, which has to be thread
+     * safe and outlive every buffer handed out. Buffers returned by `get()`
+     * pin their asset: when a load does not fit the budget, the least
+     * recently used assets nobody holds are evicted until it does, and the
+     * load fails if that is not enough.
+     *
+     * Changes are collected by `poll()` on the calling thread, so callbacks
+     * and events never run on workers.
+     */
+    class AssetManager: private NonCopyable
+    {
+    public:
+        using Clock    = std::chrono::steady_clock;
+        using Callback = std::function<void(ResidencyChange const &)>;
+
+    private:
+        /** Position in the queue, ordered by priority then deadline then arrival */
+        struct Ticket
+        {
+            Priority priority;
+            Clock::time_point deadline;
+            u64 sequence;
+            AssetId id;
+
+            auto operator<(Ticket const &rhs) const noexcept -> bool;
+        };
+
+        struct Entry
+        {
+            std::string path;
+            Residency residency;
+            Ticket ticket;
+            memory::SharedBuffer data;
+            /** Bytes counted against the budget */
+            usize size;
+            std::list<AssetId>::iterator lru;
+            /** Changed on disk while loading, loaded again once done */
+            bool stale;
+        };
+
+        /** Used when no source is given */
+        Scope<AssetSource> m_files {};
+        AssetSource &m_source;
+
+        memory::AllocatorInterface &m_allocator;
+        usize m_budget;
+        /** Bytes resident or reserved by loads in progress */
+        usize m_used { 0U };
+        /**
+         * Bytes of replaced data still pinned after a reload, given back by
+         * the release hook of each buffer, which may outlive the manager
+         */
+        std::shared_ptr<std::atomic<usize>> m_retired { std::make_shared<std::atomic<usize>>(0U) };
+
+        std::unordered_map<AssetId, Entry> m_entries {};
+        std::set<Ticket> m_queue {};
+        /** Resident assets, most recently used first */
+        std::list<AssetId> m_lru {};
+        u64 m_sequence { 0U };
+
+        std::vector<ResidencyChange> m_changes {};
+
+        std::vector<std::thread> m_workers {};
+        mutable std::mutex m_lock {};
+        std::condition_variable m_ready {};
+        bool m_stopping { false };
+
+        auto start(usize threads) -> void;
+        auto worker() -> void;
+        auto load(AssetId id, std::string const &path) -> void;
+
+        /** Resident, reserved and retired bytes, expects `m_lock` held */
+        [[nodiscard]] auto charged() const noexcept -> usize;
+
+        /** Evicts unpinned assets until `size` more bytes fit, expects `m_lock` held */
+        auto make_room(usize size) -> bool;
+        auto evict(std::unordered_map<AssetId, Entry>::iterator entry) -> void;
+        auto enqueue(AssetId id, Entry &entry, Priority priority, Clock::time_point deadline) -> void;
+        /** Drops the data of a resident or failed asset and queues it again, expects `m_lock` held */
+        auto requeue(AssetId id, Entry &entry) -> void;
+
+    public:
+        /**
+         * @param allocator thread safe allocator backing the assets
+         * @param budget bytes of assets resident at once
+         * @param threads amount of workers streaming assets in
+         */
+        AssetManager(memory::AllocatorInterface &allocator, usize budget, usize threads = 2U);
+
+        /**
+         * @param source thread safe source of the assets, outliving the manager
+         * @param allocator thread safe allocator backing the assets
+         * @param budget bytes of assets resident at once
+         * @param threads amount of workers streaming assets in
+         */
+        AssetManager(AssetSource &source, memory::AllocatorInterface &allocator, usize budget, usize threads = 2U);
+        ~AssetManager();
+
+        AssetManager(AssetManager &&)                    = delete;
+        auto operator=(AssetManager &&) -> AssetManager & = delete;
+
+        /**
+         * Queues `path` unless it is already known, returns its id
+         *
+         * Throws if another known path shares the same hash.
+         */
+        auto request(std::string_view path, Priority priority = Priority::Normal,
+                     Clock::time_point deadline = Clock::time_point::max()) -> AssetId;
+
+        /** Pins and returns a resident asset, empty otherwise */
+        [[nodiscard]] auto get(AssetId id) -> memory::SharedBuffer;
+
+        /**
+         * Forgets an asset which is queued, failed or resident and unpinned
+         *
+         * @return whether the asset is `None` afterwards
+         */
+        auto release(AssetId id) -> bool;
+
+        /**
+         * Loads a known asset again after its file changed
+         *
+         * Holders of the old data keep it, `get()` returns the new data once
+         * it is resident again. The old data counts against the budget until
+         * its last holder drops it, so pinning it can make loads fail. Paths
+         * have to match the requested ones.
+         *
+         * @return whether `path` is known
+         */
+        auto reload(std::string_view path) -> bool;
+
+        /** Changes the budget, evicting unpinned assets down to it if possible */
+        auto set_budget(usize budget) -> void;
+
+        /** Invokes `callback` for every residency change so far, without blocking */
+        auto poll(Callback const &callback) -> usize;
+
+        /** Dispatches every residency change so far as a `ResidencyEvent` */
+        template <class Dispatcher>
+        requires requires(Dispatcher &dispatcher, event::Event const &event) { dispatcher.dispatch(event); }
+        auto poll_events(Dispatcher &dispatcher) -> usize
+        {
+            return (this->poll([&dispatcher](ResidencyChange const &change) -> void {
+                dispatcher.dispatch(ResidencyEvent { change });
+            }));
+        }
+
+        [[nodiscard]] auto residency(AssetId id) const -> Residency;
+        [[nodiscard]] auto budget() const -> usize;
+
+        /** Bytes resident, reserved by loads in progress or still pinned after a reload */
+        [[nodiscard]] auto used() const -> usize;
+    };
+}  // namespace assets
@@ -0,0 +1,88 @@
+/** @file asset_source.cpp */
+
+// module includes
+#include "asset_source.hpp"
+#include "assets/io/mapped_file.hpp"
+
+// c++ includes
+#include <cstring>
+#include <filesystem>
+
+
+namespace assets
+{
+    // ============================================================================================== //
+    // FileSource implementation ==================================================================== //
+    // ============================================================================================== //
+
+    auto FileSource::size(std::string const &path) -> std::optional<usize>
+    {
+        std::error_code error {};
+        auto size = std::filesystem::file_size(path, error);
+        if (error) {
+            return (std::nullopt);
+        }
+
+        return (static_cast<usize>(size));
+    }
+
+    auto FileSource::read(std::string const &path, memory::BufferRef dst) -> bool
+    {
+        io::file::MappedFile file { path, io::file::MapHint::Sequential };
+
+        // the file changed since its size was taken
+        if (file.length() != dst.length()) {
+            return (false);
+        }
+
+        if (!file.empty()) {
+            std::memcpy(dst.data(), file.view().data(), dst.length());
+        }
+
+        return (true);
+    }
+
+    // ============================================================================================== //
+    // ArchiveSource implementation ================================================================= //
+    // ============================================================================================== //
+
+    ArchiveSource::ArchiveSource(io::Archive const &archive, io::Decompressor &decompressor) noexcept
+      : m_archive { archive }, m_decompressor { decompressor }
+    {
+    }
+
+    auto ArchiveSource::size(std::string const &path) -> std::optional<usize>
+    {
+        auto const *entry = m_archive.find(path);
+        if (entry == nullptr) {
+            return (std::nullopt);
+        }
+
+        return (static_cast<usize>(entry->raw_size));
+    }
+
+    auto ArchiveSource::read(std::string const &path, memory::BufferRef dst) -> bool
+    {
+        auto const *entry = m_archive.find(path);
+        if ((entry == nullptr) || (entry->raw_size != dst.length())) {
+            return (false);
+        }
+
+        auto payload = m_archive.read(*entry);
+
+        if (m_archive.compression(*entry) == io::Compression::None) {
+            if (payload.length() != dst.length()) {
+                return (false);
+            }
+
+            if (!dst.empty()) {
+                std::memcpy(dst.data(), payload.data(), dst.length());
+            }
+
+            return (true);
+        }
+
+        // throws on malformed payloads, failing the load
+        return (m_decompressor.decompress(payload, dst) == dst.length());
+    }
+}  // namespace assets
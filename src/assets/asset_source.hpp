@@ -0,0 +1,72 @@
+/** @file asset_source.hpp */
+
+#pragma once
+
+// module includes
+#include "assets/io/archive.hpp"
+#include "assets/io/compression.hpp"
+#include "memory/buffer_ref.hpp"
+#include "util/util.hpp"
+
+// c++ includes
+#include <optional>
+#include <string>
+
+
+namespace assets
+{
+    /**
+     * Where an `AssetManager` reads its assets from
+     *
+     * Both calls are made by the workers of the manager, concurrently.
+     */
+    class AssetSource
+    {
+    public:
+        AssetSource()                                  = default;
+        AssetSource(AssetSource const &)               = delete;
+        AssetSource(AssetSource &&)                    = delete;
+        auto operator=(AssetSource const &) -> AssetSource & = delete;
+        auto operator=(AssetSource &&) -> AssetSource      & = delete;
+
+        virtual ~AssetSource() = default;
+
+        /** Size of `path` once loaded, empty if it cannot be read */
+        [[nodiscard]] virtual auto size(std::string const &path) -> std::optional<usize> = 0;
+
+        /**
+         * Fills `dst` with the contents of `path`
+         *
+         * @param dst buffer of the size reported by `size()`
+         * @return false if `path` is unreadable or no longer of that size
+         */
+        virtual auto read(std::string const &path, memory::BufferRef dst) -> bool = 0;
+    };
+
+    /** Reads assets from loose files, mapping them rather than streaming */
+    class FileSource final: public AssetSource
+    {
+    public:
+        [[nodiscard]] auto size(std::string const &path) -> std::optional<usize> override;
+        auto read(std::string const &path, memory::BufferRef dst) -> bool override;
+    };
+
+    /**
+     * Reads assets from the entries of an archive
+     *
+     * Compressed entries are decompressed straight into the asset buffer.
+     * The archive and the decompressor have to outlive the source.
+     */
+    class ArchiveSource final: public AssetSource
+    {
+    private:
+        io::Archive const &m_archive;
+        io::Decompressor &m_decompressor;
+
+    public:
+        ArchiveSource(io::Archive const &archive, io::Decompressor &decompressor) noexcept;
+
+        [[nodiscard]] auto size(std::string const &path) -> std::optional<usize> override;
+        auto read(std::string const &path, memory::BufferRef dst) -> bool override;
+    };
+}  // namespace assets
@@ -0,0 +1,350 @@
+/** @file archive.cpp */
+
+// module includes
+#include "archive.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+// logging
+#include "spdlog/spdlog.h"
+
+
+namespace assets::io
+{
+    namespace
+    {
+        auto align_offset(std::uint64_t offset, std::uint64_t alignment) noexcept -> std::uint64_t
+        {
+            return ((offset + alignment - 1U) & ~(alignment - 1U));
+        }
+
+        auto write_bytes(std::ofstream &out, void const *data, usize size) -> void
+        {
+            out.write(static_cast<char const *>(data), static_cast<std::streamsize>(size));
+        }
+
+        auto write_padding(std::ofstream &out, std::uint64_t from, std::uint64_t to) -> void
+        {
+            std::array<char, 512> static const zeroes {};
+
+            for (auto left = to - from; left > 0U;) {
+                auto count = std::min<std::uint64_t>(left, zeroes.size());
+                write_bytes(out, zeroes.data(), count);
+                left -= count;
+            }
+        }
+    }  // namespace
+
+    auto archive_hash(std::string_view path) noexcept -> std::uint32_t
+    {
+        // `u32` is `uint_fast32_t`, 64 bits wide on most targets. `hash_str` only shifts left, adds and
+        // xors, so its low 32 bits are the same whatever the width. They are stored, pin them.
+        static_assert(static_cast<std::uint32_t>(util::string::hash_str("textures/atlas.png")) == 2180566170U,
+                      "archive hashes are part of the format");
+
+        return (static_cast<std::uint32_t>(util::string::hash_str(path)));
+    }
+
+    // ============================================================================================== //
+    // Archive implementation ======================================================================= //
+    // ============================================================================================== //
+
+    Archive::Archive(std::string_view path): m_file { path, file::MapHint::Random }
+    {
+        SCOPE_FAIL
+        {
+            spdlog::error(fmt::format("IO/ERROR: \'{}\' is not a valid archive", path));
+        };
+
+        auto bytes = m_file.view();
+        if (bytes.length() < sizeof(ArchiveHeader)) {
+            throw std::runtime_error("Archive too small");
+        }
+
+        m_header = bytes.as_ptr<ArchiveHeader const *>();
+
+        if ((m_header->magic != ARCHIVE_MAGIC) || (m_header->version != ARCHIVE_VERSION)) {
+            throw std::runtime_error("Unknown archive format");
+        }
+
+        if ((m_header->size != bytes.length()) || !std::has_single_bit(m_header->alignment)) {
+            throw std::runtime_error("Corrupted archive header");
+        }
+
+        auto toc   = bytes.subview(m_header->toc_offset, usize { m_header->count } * sizeof(ArchiveEntry));
+        auto names = bytes.subview(m_header->names_offset, m_header->names_size);
+
+        m_entries = toc.as_span<ArchiveEntry const>();
+        m_names   = std::string_view { names.as_ptr<char const *>(), names.length() };
+
+        for (auto const &entry : m_entries) {
+            auto name_end    = std::uint64_t { entry.name_offset } + entry.name_length;
+            auto payload_end = entry.offset + entry.size;
+
+            if ((name_end > m_names.size()) || (payload_end < entry.offset) || (payload_end > m_header->size)) {
+                throw std::runtime_error("Corrupted archive entry");
+            }
+        }
+    }
+
+    auto Archive::find(std::string_view path) const noexcept -> ArchiveEntry const *
+    {
+        auto hash  = archive_hash(path);
+        auto first = std::lower_bound(m_entries.begin(), m_entries.end(), hash,
+                                      [](ArchiveEntry const &entry, std::uint32_t key) { return (entry.hash < key); });
+
+        for (auto it = first; (it != m_entries.end()) && (it->hash == hash); ++it) {
+            if (this->name(*it) == path) {
+                return (&*it);
+            }
+        }
+
+        return (nullptr);
+    }
+
+    auto Archive::read(std::string_view path) const noexcept -> memory::BufferRef
+    {
+        auto const *entry = this->find(path);
+
+        return ((entry != nullptr) ? this->read(*entry) : memory::BufferRef {});
+    }
+
+    auto Archive::read(ArchiveEntry const &entry) const noexcept -> memory::BufferRef
+    {
+        auto *base = static_cast<u8 *>(m_file.view().data());
+
+        return (memory::BufferRef { base + entry.offset, static_cast<usize>(entry.size) });
+    }
+
+    auto Archive::name(ArchiveEntry const &entry) const noexcept -> std::string_view
+    {
+        return (m_names.substr(entry.name_offset, entry.name_length));
+    }
+
+    auto Archive::type(ArchiveEntry const &entry) const noexcept -> file::FileType
+    {
+        return (static_cast<file::FileType>(entry.type));
+    }
+
+    auto Archive::compression(ArchiveEntry const &entry) const noexcept -> Compression
+    {
+        return (static_cast<Compression>(entry.compression));
+    }
+
+    auto Archive::entries() const noexcept -> std::span<ArchiveEntry const>
+    {
+        return (m_entries);
+    }
+
+    auto Archive::size() const noexcept -> usize
+    {
+        return (m_entries.size());
+    }
+
+    // ============================================================================================== //
+    // ArchiveBuilder implementation ================================================================ //
+    // ============================================================================================== //
+
+    ArchiveBuilder::ArchiveBuilder(std::uint32_t alignment): m_alignment { alignment }
+    {
+        if (!std::has_single_bit(alignment)) {
+            spdlog::error(fmt::format("IO/ERROR: Archive alignment {} is not a power of two", alignment));
+            throw std::runtime_error("Invalid archive alignment");
+        }
+    }
+
+    auto ArchiveBuilder::claim(std::string_view path) -> void
+    {
+        if (!m_paths.emplace(path).second) {
+            spdlog::error(fmt::format("IO/ERROR: \'{}\' was already added to the archive", path));
+            throw std::runtime_error("Duplicate archive entry");
+        }
+    }
+
+    auto ArchiveBuilder::with_compression(Compression codec) -> ArchiveBuilder &
+    {
+        if (!codec_available(codec)) {
+            spdlog::error(fmt::format("IO/ERROR: Compression codec {} is unavailable in this build",
+                                      static_cast<std::uint16_t>(codec)));
+            throw std::runtime_error("Unavailable compression codec");
+        }
+
+        m_compression = codec;
+        return (*this);
+    }
+
+    auto ArchiveBuilder::add_file(std::string_view path, std::filesystem::path const &source) -> ArchiveBuilder &
+    {
+        this->claim(path);
+
+        auto type = file::type_from_path(source.string());
+        m_pending.push_back(Pending { std::string { path }, source, type, Compression::None, 0U });
+
+        return (*this);
+    }
+
+    auto ArchiveBuilder::add(std::string_view path, memory::BufferRef data, file::FileType type,
+                             Compression compression) -> ArchiveBuilder &
+    {
+        auto raw_size = (compression == Compression::None) ? data.length() : decompressed_size(data);
+
+        this->claim(path);
+        m_pending.push_back(Pending { std::string { path }, data, type, compression, raw_size });
+
+        return (*this);
+    }
+
+    auto ArchiveBuilder::write(std::filesystem::path const &path) const -> void
+    {
+        auto staging = path;
+        staging += ".tmp";
+
+        SCOPE_FAIL
+        {
+            spdlog::error(fmt::format("IO/ERROR: Archive \'{}\' could not be written", path.string()));
+
+            std::error_code ignored {};
+            std::filesystem::remove(staging, ignored);
+        };
+
+        std::vector<usize> order(m_pending.size());
+        std::iota(order.begin(), order.end(), 0U);
+
+        std::vector<std::uint32_t> hashes {};
+        hashes.reserve(m_pending.size());
+        for (auto const &pending : m_pending) {
+            hashes.push_back(archive_hash(pending.path));
+        }
+
+        std::sort(order.begin(), order.end(), [&](usize lhs, usize rhs) {
+            return ((hashes[lhs] != hashes[rhs]) ? (hashes[lhs] < hashes[rhs])
+                                                 : (m_pending[lhs].path < m_pending[rhs].path));
+        });
+
+        ArchiveHeader header {};
+        header.magic        = ARCHIVE_MAGIC;
+        header.version      = ARCHIVE_VERSION;
+        header.count        = static_cast<std::uint32_t>(m_pending.size());
+        header.alignment    = m_alignment;
+        header.toc_offset   = sizeof(ArchiveHeader);
+        header.names_offset = header.toc_offset + (m_pending.size() * sizeof(ArchiveEntry));
+
+        std::vector<ArchiveEntry> entries(m_pending.size());
+
+        std::string names {};
+        for (auto i = usize { 0U }; i < order.size(); ++i) {
+            auto const &pending = m_pending[order[i]];
+
+            if ((names.size() + pending.path.size()) > std::numeric_limits<std::uint32_t>::max()) {
+                throw std::runtime_error("Archive names overflow");
+            }
+
+            entries[i].hash        = hashes[order[i]];
+            entries[i].type        = static_cast<std::uint16_t>(pending.type);
+            entries[i].name_offset = static_cast<std::uint32_t>(names.size());
+            entries[i].name_length = static_cast<std::uint32_t>(pending.path.size());
+
+            names += pending.path;
+        }
+
+        header.names_size = names.size();
+
+        std::ofstream out { staging, std::ios::out | std::ios::binary | std::ios::trunc };
+        if (!out) {
+            throw std::runtime_error("Cannot create archive");
+        }
+
+        // header and table of contents are rewritten once payloads are placed
+        write_bytes(out, &header, sizeof(header));
+        write_bytes(out, entries.data(), entries.size() * sizeof(ArchiveEntry));
+        write_bytes(out, names.data(), names.size());
+
+        auto cursor = header.names_offset + header.names_size;
+
+        std::vector<char> chunk(64U * 1024U);
+        for (auto i = usize { 0U }; i < entries.size(); ++i) {
+            auto &entry         = entries[i];
+            auto const &pending = m_pending[order[i]];
+
+            entry.offset = align_offset(cursor, m_alignment);
+            write_padding(out, cursor, entry.offset);
+
+            auto const *source = std::get_if<std::filesystem::path>(&pending.source);
+
+            if ((source != nullptr) && (m_compression == Compression::None)) {
+                std::ifstream in { *source, std::ios::in | std::ios::binary };
+
+                entry.size     = std::filesystem::file_size(*source);
+                entry.raw_size = entry.size;
+
+                auto left = entry.size;
+                while ((left > 0U) && in) {
+                    in.read(chunk.data(), static_cast<std::streamsize>(std::min<std::uint64_t>(left, chunk.size())));
+                    write_bytes(out, chunk.data(), static_cast<usize>(in.gcount()));
+                    left -= static_cast<std::uint64_t>(in.gcount());
+                }
+
+                if (left > 0U) {
+                    spdlog::error(fmt::format("IO/ERROR: \'{}\' changed while archiving", source->string()));
+                    throw std::runtime_error("Archive source truncated");
+                }
+            } else if (source != nullptr) {
+                // compressing needs the whole file at once
+                std::ifstream in { *source, std::ios::in | std::ios::binary };
+                std::vector<char> contents { std::istreambuf_iterator<char> { in }, std::istreambuf_iterator<char> {} };
+
+                if (in.bad()) {
+                    spdlog::error(fmt::format("IO/ERROR: \'{}\' could not be read", source->string()));
+                    throw std::runtime_error("Cannot read archive source");
+                }
+
+                entry.raw_size = contents.size();
+                entry.size     = contents.size();
+
+                auto packed = compress(m_compression, memory::BufferRef { contents.data(), contents.size() });
+
+                // only keep the compressed form if it pays for its header
+                if (packed.size() < contents.size()) {
+                    entry.compression = static_cast<std::uint16_t>(m_compression);
+                    entry.size        = packed.size();
+                    write_bytes(out, packed.data(), packed.size());
+                } else {
+                    write_bytes(out, contents.data(), contents.size());
+                }
+            } else {
+                auto data = std::get<memory::BufferRef>(pending.source);
+
+                entry.compression = static_cast<std::uint16_t>(pending.compression);
+                entry.size        = data.length();
+                entry.raw_size    = pending.raw_size;
+                write_bytes(out, data.data(), data.length());
+            }
+
+            cursor = entry.offset + entry.size;
+        }
+
+        header.size = cursor;
+
+        out.seekp(0);
+        write_bytes(out, &header, sizeof(header));
+        write_bytes(out, entries.data(), entries.size() * sizeof(ArchiveEntry));
+
+        out.close();
+        if (!out) {
+            throw std::runtime_error("Cannot write archive");
+        }
+
+        std::filesystem::rename(staging, path);
+    }
+
+    auto ArchiveBuilder::size() const noexcept -> usize
+    {
+        return (m_pending.size());
+    }
+}  // namespace assets::io
@@ -0,0 +1,161 @@
+/** @file archive.hpp */
+
+#pragma once
+
+// module includes
+#include "compression.hpp"
+#include "file.hpp"
+#include "mapped_file.hpp"
+#include "memory/buffer_ref.hpp"
+#include "util/util.hpp"
+
+// c++ includes
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+
+namespace assets::io
+{
+    static_assert(std::endian::native == std::endian::little, "archives are stored little endian");
+
+    /**
+     * Leading bytes of an archive
+     *
+     * The table of contents follows the header, sorted by hash, then the
+     * names it points into. Payloads come last, each on an `alignment`
+     * boundary so that it starts on its own page once mapped.
+     */
+    struct ArchiveHeader
+    {
+        std::array<char, 4> magic;
+        std::uint16_t version;
+        std::uint16_t reserved;
+        std::uint32_t count;
+        std::uint32_t alignment;
+        std::uint64_t toc_offset;
+        std::uint64_t names_offset;
+        std::uint64_t names_size;
+        /** Size of the whole archive */
+        std::uint64_t size;
+    };
+
+    /** Table of contents entry */
+    struct ArchiveEntry
+    {
+        /** `util::string::hash_str` of the path, truncated to 32 bits */
+        std::uint32_t hash;
+        /** `file::FileType` of the entry */
+        std::uint16_t type;
+        /** `Compression` of the payload */
+        std::uint16_t compression;
+        std::uint32_t name_offset;
+        std::uint32_t name_length;
+        std::uint64_t offset;
+        /** Stored payload size */
+        std::uint64_t size;
+        /** Payload size once decompressed */
+        std::uint64_t raw_size;
+    };
+
+    static_assert(sizeof(ArchiveHeader) == 48U, "archive header layout is part of the format");
+    static_assert(sizeof(ArchiveEntry) == 40U, "archive entry layout is part of the format");
+
+    std::array<char, 4> static constexpr const ARCHIVE_MAGIC = { 'W', 'P', 'A', 'K' };
+    std::uint16_t static constexpr const ARCHIVE_VERSION     = { 1U };
+    std::uint32_t static constexpr const ARCHIVE_ALIGNMENT   = { 4096U };
+
+    /** Hash keying archive entries, stable across platforms */
+    [[nodiscard]] auto archive_hash(std::string_view path) noexcept -> std::uint32_t;
+
+    /**
+     * Read-only archive, mapped once and viewed in place
+     *
+     * Lookups binary search the table of contents and compare names on hash
+     * collisions. Payloads are returned as stored, compressed ones are
+     * chunked payloads to hand to a `Decompressor`.
+     */
+    class Archive
+    {
+    private:
+        file::MappedFile m_file {};
+
+        ArchiveHeader const *m_header { nullptr };
+        std::span<ArchiveEntry const> m_entries {};
+        std::string_view m_names {};
+
+    public:
+        /** Maps and validates `path`, throws on malformed archives */
+        explicit Archive(std::string_view path);
+
+        [[nodiscard]] auto find(std::string_view path) const noexcept -> ArchiveEntry const *;
+
+        /** Stored payload of `path`, empty when absent */
+        [[nodiscard]] auto read(std::string_view path) const noexcept -> memory::BufferRef;
+        [[nodiscard]] auto read(ArchiveEntry const &entry) const noexcept -> memory::BufferRef;
+
+        [[nodiscard]] auto name(ArchiveEntry const &entry) const noexcept -> std::string_view;
+        [[nodiscard]] auto type(ArchiveEntry const &entry) const noexcept -> file::FileType;
+        [[nodiscard]] auto compression(ArchiveEntry const &entry) const noexcept -> Compression;
+
+        [[nodiscard]] auto entries() const noexcept -> std::span<ArchiveEntry const>;
+        [[nodiscard]] auto size() const noexcept -> usize;
+    };
+
+    /**
+     * Lays out entries and writes them as an archive
+     *
+     * Files are only read while writing, one at a time, and compressed on
+     * the way if a codec was set. Borrowed buffers must stay alive until
+     * then.
+     */
+    class ArchiveBuilder
+    {
+    private:
+        struct Pending
+        {
+            std::string path;
+            std::variant<std::filesystem::path, memory::BufferRef> source;
+            file::FileType type;
+            Compression compression;
+            usize raw_size;
+        };
+
+        std::vector<Pending> m_pending {};
+        std::unordered_set<std::string> m_paths {};
+        std::uint32_t m_alignment;
+        Compression m_compression { Compression::None };
+
+        /** Registers `path`, throws if it was already added */
+        auto claim(std::string_view path) -> void;
+
+    public:
+        explicit ArchiveBuilder(std::uint32_t alignment = ARCHIVE_ALIGNMENT);
+
+        /** Compresses files added with `add_file` with `codec`, throws if unavailable */
+        auto with_compression(Compression codec) -> ArchiveBuilder &;
+
+        /** Adds the file at `source` as `path`, typed by its extension */
+        auto add_file(std::string_view path, std::filesystem::path const &source) -> ArchiveBuilder &;
+
+        /**
+         * Adds `data` as `path`
+         *
+         * @param compression codec of `data` if it is a chunked payload from `compress()`
+         */
+        auto add(std::string_view path, memory::BufferRef data, file::FileType type,
+                 Compression compression = Compression::None) -> ArchiveBuilder &;
+
+        /** Writes the archive to `path`, throws on I/O errors */
+        auto write(std::filesystem::path const &path) const -> void;
+
+        [[nodiscard]] auto size() const noexcept -> usize;
+    };
+}  // namespace assets::io
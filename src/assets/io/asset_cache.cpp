@@ -0,0 +1,405 @@
+/** @file asset_cache.cpp */
+
+// module includes
+#include "asset_cache.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// logging
+#include "spdlog/spdlog.h"
+
+
+namespace assets::io
+{
+    namespace
+    {
+        std::uint64_t static constexpr const PRIME_1 = { 0x9E3779B97F4A7C15ULL };
+        std::uint64_t static constexpr const PRIME_2 = { 0xC2B2AE3D27D4EB4FULL };
+        std::uint64_t static constexpr const PRIME_3 = { 0x165667B19E3779F9ULL };
+
+        auto inline read64(std::uint8_t const *src) noexcept -> std::uint64_t
+        {
+            std::uint64_t value {};
+            std::memcpy(&value, src, sizeof(value));
+
+            return (value);
+        }
+
+        auto inline round(std::uint64_t lane, std::uint64_t word) noexcept -> std::uint64_t
+        {
+            return (std::rotl(lane + (word * PRIME_2), 31) * PRIME_1);
+        }
+
+        /** splitmix64 finalizer */
+        auto inline avalanche(std::uint64_t hash) noexcept -> std::uint64_t
+        {
+            hash = (hash ^ (hash >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+            hash = (hash ^ (hash >> 27U)) * 0x94D049BB133111EBULL;
+
+            return (hash ^ (hash >> 31U));
+        }
+
+        auto write_bytes(std::ofstream &out, void const *data, usize size) -> void
+        {
+            out.write(static_cast<char const *>(data), static_cast<std::streamsize>(size));
+        }
+
+        /** Writes `path` through a staging file, so that it is never seen half written */
+        template <class Writer>
+        auto write_atomically(std::filesystem::path const &path, Writer &&writer) -> void
+        {
+            auto staging = path;
+            staging += ".tmp";
+
+            SCOPE_FAIL
+            {
+                spdlog::error(fmt::format("IO/ERROR: \'{}\' could not be written", path.string()));
+
+                std::error_code ignored {};
+                std::filesystem::remove(staging, ignored);
+            };
+
+            std::ofstream out { staging, std::ios::out | std::ios::binary | std::ios::trunc };
+            if (!out) {
+                throw std::runtime_error("Cannot create cache file");
+            }
+
+            writer(out);
+
+            out.close();
+            if (!out) {
+                throw std::runtime_error("Cannot write cache file");
+            }
+
+            std::filesystem::rename(staging, path);
+        }
+
+        auto path_hash(std::string_view key) noexcept -> std::uint64_t
+        {
+            return (content_hash(memory::BufferRef { key.data(), key.size() }));
+        }
+    }  // namespace
+
+    auto content_hash(memory::BufferRef data, std::uint64_t seed) noexcept -> std::uint64_t
+    {
+        auto const *bytes = static_cast<std::uint8_t const *>(data.data());
+        auto length       = data.length();
+        auto hash         = seed + PRIME_3 + length;
+
+        // four independent lanes keep the multipliers busy on large inputs
+        if (length >= 32U) {
+            std::array<std::uint64_t, 4> lanes = { seed + PRIME_1 + PRIME_2, seed + PRIME_2, seed, seed - PRIME_1 };
+
+            for (; length >= 32U; bytes += 32U, length -= 32U) {
+                for (auto i = usize { 0U }; i < lanes.size(); ++i) {
+                    lanes[i] = round(lanes[i], read64(bytes + (i * 8U)));
+                }
+            }
+
+            hash += std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+        }
+
+        for (; length >= 8U; bytes += 8U, length -= 8U) {
+            hash = round(hash, read64(bytes));
+        }
+
+        if (length > 0U) {
+            std::uint64_t tail {};
+            std::memcpy(&tail, bytes, length);
+            hash = round(hash, tail ^ (std::uint64_t { length } << 56U));
+        }
+
+        return (avalanche(hash));
+    }
+
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    AssetCache::AssetCache(std::filesystem::path root): m_root { std::move(root) }
+    {
+        std::filesystem::create_directories(m_root / "blobs");
+
+        try {
+            this->map_index();
+        } catch (std::exception const &error) {
+            spdlog::warn(fmt::format("IO/WARN: Ignoring cache index in \'{}\', {}", m_root.string(), error.what()));
+
+            m_index   = file::MappedFile {};
+            m_records = {};
+            m_names   = {};
+
+            std::error_code ignored {};
+            std::filesystem::remove(m_root / "index.bin", ignored);
+        }
+    }
+
+    AssetCache::~AssetCache()
+    {
+        try {
+            this->flush();
+        } catch (std::exception const &error) {
+            spdlog::error(fmt::format("IO/ERROR: Cache index in \'{}\' is stale, {}", m_root.string(), error.what()));
+        }
+    }
+
+    // ============================================================================================== //
+    // Utility methods ============================================================================== //
+    // ============================================================================================== //
+
+    auto AssetCache::map_index() -> void
+    {
+        auto path = m_root / "index.bin";
+        if (!std::filesystem::exists(path)) {
+            return;
+        }
+
+        m_index = file::MappedFile { path.string(), file::MapHint::Random };
+
+        auto bytes = m_index.view();
+        if (bytes.length() < sizeof(CacheHeader)) {
+            throw std::runtime_error("truncated header");
+        }
+
+        auto const *header = bytes.as_ptr<CacheHeader const *>();
+        if ((header->magic != CACHE_MAGIC) || (header->version != CACHE_VERSION)) {
+            throw std::runtime_error("unknown format");
+        }
+
+        auto records = bytes.subview(sizeof(CacheHeader), usize { header->count } * sizeof(CacheRecord));
+        auto names   = bytes.subview(sizeof(CacheHeader) + records.length(), header->names_size);
+
+        m_records = records.as_span<CacheRecord const>();
+        m_names   = std::string_view { names.as_ptr<char const *>(), names.length() };
+
+        for (auto const &record : m_records) {
+            if ((std::uint64_t { record.name_offset } + record.name_length) > m_names.size()) {
+                throw std::runtime_error("corrupted record");
+            }
+        }
+    }
+
+    auto AssetCache::mapped(std::string_view key) const noexcept -> CacheRecord const *
+    {
+        auto hash  = path_hash(key);
+        auto first = std::lower_bound(m_records.begin(), m_records.end(), hash,
+                                      [](CacheRecord const &record, std::uint64_t value) { return (record.path_hash < value); });
+
+        for (auto it = first; (it != m_records.end()) && (it->path_hash == hash); ++it) {
+            if (m_names.substr(it->name_offset, it->name_length) == key) {
+                return (&*it);
+            }
+        }
+
+        return (nullptr);
+    }
+
+    auto AssetCache::record(std::string const &key) const -> std::optional<Record>
+    {
+        if (auto update = m_updates.find(key); update != m_updates.end()) {
+            return (update->second);
+        }
+
+        auto const *mapped = this->mapped(key);
+        if (mapped == nullptr) {
+            return (std::nullopt);
+        }
+
+        return (Record { mapped->source_hash, mapped->mtime, mapped->size, mapped->importer,
+                         static_cast<file::FileType>(mapped->type) });
+    }
+
+    auto AssetCache::blob_path(std::uint64_t source_hash, std::uint32_t importer) const -> std::filesystem::path
+    {
+        return (m_root / "blobs" / fmt::format("{:016x}-{:08x}", source_hash, importer));
+    }
+
+    // ============================================================================================== //
+    // AssetCache implementation ==================================================================== //
+    // ============================================================================================== //
+
+    auto AssetCache::find(std::filesystem::path const &source, std::uint32_t importer) -> std::optional<CachedAsset>
+    {
+        auto key    = source.generic_string();
+        auto record = this->record(key);
+
+        if (!record || (record->importer != importer)) {
+            return (std::nullopt);
+        }
+
+        std::error_code error {};
+        auto size = std::filesystem::file_size(source, error);
+        if (error || (size != record->size)) {
+            return (std::nullopt);
+        }
+
+        auto mtime = std::filesystem::last_write_time(source, error).time_since_epoch().count();
+        if (error) {
+            return (std::nullopt);
+        }
+
+        if (mtime != record->mtime) {
+            // touched but maybe not modified, e.g. by a checkout, the contents decide
+            file::MappedFile contents { key, file::MapHint::Sequential };
+            if (content_hash(contents.view()) != record->source_hash) {
+                return (std::nullopt);
+            }
+
+            record->mtime  = mtime;
+            m_updates[key] = *record;
+        }
+
+        auto blob = this->blob_path(record->source_hash, importer);
+        if (!std::filesystem::exists(blob, error)) {
+            return (std::nullopt);
+        }
+
+        return (CachedAsset { file::MappedFile { blob.string(), file::MapHint::Sequential }, record->type });
+    }
+
+    auto AssetCache::store(std::filesystem::path const &source, std::uint32_t importer, memory::BufferRef data) -> void
+    {
+        auto key = source.generic_string();
+
+        SCOPE_FAIL
+        {
+            spdlog::error(fmt::format("IO/ERROR: \'{}\' could not be cached", key));
+        };
+
+        // stat before hashing, a write in between then only costs a rehash
+        auto size  = std::filesystem::file_size(source);
+        auto mtime = std::filesystem::last_write_time(source).time_since_epoch().count();
+
+        file::MappedFile contents { key, file::MapHint::Sequential };
+        auto source_hash = content_hash(contents.view());
+
+        auto blob = this->blob_path(source_hash, importer);
+        if (!std::filesystem::exists(blob)) {
+            write_atomically(blob, [&](std::ofstream &out) { write_bytes(out, data.data(), data.length()); });
+        }
+
+        m_updates[key] = Record { source_hash, mtime, size, importer, file::type_from_path(key) };
+    }
+
+    auto AssetCache::flush() -> void
+    {
+        if (m_updates.empty()) {
+            return;
+        }
+
+        std::vector<CacheRecord> records {};
+        std::string names {};
+
+        auto append = [&](std::string_view key, CacheRecord record) -> void {
+            if ((names.size() + key.size()) > std::numeric_limits<std::uint32_t>::max()) {
+                throw std::runtime_error("Cache names overflow");
+            }
+
+            record.name_offset = static_cast<std::uint32_t>(names.size());
+            record.name_length = static_cast<std::uint32_t>(key.size());
+            records.push_back(record);
+
+            names += key;
+        };
+
+        for (auto const &record : m_records) {
+            auto key = m_names.substr(record.name_offset, record.name_length);
+            if (!m_updates.contains(std::string { key })) {
+                append(key, record);
+            }
+        }
+
+        for (auto const &[key, record] : m_updates) {
+            append(key, CacheRecord { path_hash(key), record.source_hash, record.mtime, record.size, record.importer,
+                                      static_cast<std::uint16_t>(record.type), 0U, 0U, 0U });
+        }
+
+        std::sort(records.begin(), records.end(), [&](CacheRecord const &lhs, CacheRecord const &rhs) {
+            if (lhs.path_hash != rhs.path_hash) {
+                return (lhs.path_hash < rhs.path_hash);
+            }
+
+            return (std::string_view { names }.substr(lhs.name_offset, lhs.name_length)
+                    < std::string_view { names }.substr(rhs.name_offset, rhs.name_length));
+        });
+
+        CacheHeader header {};
+        header.magic      = CACHE_MAGIC;
+        header.version    = CACHE_VERSION;
+        header.count      = static_cast<std::uint32_t>(records.size());
+        header.names_size = names.size();
+
+        // records and names are copies, the old index can go before it is replaced
+        m_records = {};
+        m_names   = {};
+        m_index   = file::MappedFile {};
+
+        // the old index is still on disk, map it back so its records are not lost on the next flush
+        SCOPE_FAIL
+        {
+            try {
+                this->map_index();
+            } catch (std::exception const &error) {
+                m_records = {};
+                m_names   = {};
+                m_index   = file::MappedFile {};
+
+                spdlog::error(
+                    fmt::format("IO/ERROR: Cache index in \'{}\' could not be mapped back, {}", m_root.string(),
+                                error.what()));
+            }
+        };
+
+        write_atomically(m_root / "index.bin", [&](std::ofstream &out) {
+            write_bytes(out, &header, sizeof(header));
+            write_bytes(out, records.data(), records.size() * sizeof(CacheRecord));
+            write_bytes(out, names.data(), names.size());
+        });
+
+        m_updates.clear();
+        this->map_index();
+    }
+
+    auto AssetCache::prune() -> usize
+    {
+        this->flush();
+
+        std::unordered_set<std::string> live {};
+        for (auto const &record : m_records) {
+            live.insert(this->blob_path(record.source_hash, record.importer).filename().string());
+        }
+
+        auto removed = usize { 0U };
+        for (auto const &entry : std::filesystem::directory_iterator { m_root / "blobs" }) {
+            if (live.contains(entry.path().filename().string())) {
+                continue;
+            }
+
+            std::error_code error {};
+            if (std::filesystem::remove(entry.path(), error)) {
+                ++removed;
+            }
+        }
+
+        return (removed);
+    }
+
+    auto AssetCache::size() const -> usize
+    {
+        auto count = m_records.size();
+
+        for (auto const &update : m_updates) {
+            count += (this->mapped(update.first) == nullptr) ? 1U : 0U;
+        }
+
+        return (count);
+    }
+}  // namespace assets::io
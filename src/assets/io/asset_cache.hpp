@@ -0,0 +1,144 @@
+/** @file asset_cache.hpp */
+
+#pragma once
+
+// module includes
+#include "file.hpp"
+#include "mapped_file.hpp"
+#include "memory/buffer_ref.hpp"
+#include "util/util.hpp"
+
+// c++ includes
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+
+namespace assets::io
+{
+    static_assert(std::endian::native == std::endian::little, "cache indices are stored little endian");
+
+    /**
+     * Leading bytes of a cache index
+     *
+     * Records follow the header, sorted by path hash, then the source paths
+     * they point into.
+     */
+    struct CacheHeader
+    {
+        std::array<char, 4> magic;
+        std::uint16_t version;
+        std::uint16_t reserved;
+        std::uint32_t count;
+        std::uint32_t padding;
+        std::uint64_t names_size;
+    };
+
+    /** Processed source, as it was when it was stored */
+    struct CacheRecord
+    {
+        /** `content_hash` of the source path */
+        std::uint64_t path_hash;
+        /** `content_hash` of the source contents */
+        std::uint64_t source_hash;
+        /** Last write time of the source, in ticks of its clock */
+        std::int64_t mtime;
+        std::uint64_t size;
+        std::uint32_t importer;
+        /** `file::FileType` of the source */
+        std::uint16_t type;
+        std::uint16_t reserved;
+        std::uint32_t name_offset;
+        std::uint32_t name_length;
+    };
+
+    static_assert(sizeof(CacheHeader) == 24U, "cache header layout is part of the format");
+    static_assert(sizeof(CacheRecord) == 48U, "cache record layout is part of the format");
+
+    std::array<char, 4> static constexpr const CACHE_MAGIC = { 'W', 'C', 'A', 'C' };
+    std::uint16_t static constexpr const CACHE_VERSION     = { 1U };
+
+    /** Fast non-cryptographic 64 bits hash of `data` */
+    [[nodiscard]] auto content_hash(memory::BufferRef data, std::uint64_t seed = 0U) noexcept -> std::uint64_t;
+
+    /** Processed asset found in the cache */
+    struct CachedAsset
+    {
+        file::MappedFile blob;
+        /** Type of the source, as classified when it was stored */
+        file::FileType type;
+    };
+
+    /**
+     * Persistent cache of processed assets
+     *
+     * Blobs live in `<root>/blobs`, named after the hash of their source
+     * and the importer version, so identical sources share them. The index
+     * in `<root>/index.bin` maps source paths to blobs and is mapped and
+     * searched in place, nothing is parsed on startup.
+     *
+     * A source whose size and write time match its record is a hit without
+     * being read. When only the write time changed, the source is hashed
+     * and still hits if its contents did not change.
+     *
+     * Changes are kept in memory until `flush()`, which the destructor calls.
+     * Not synchronized, one process and one thread at a time.
+     */
+    class AssetCache: private NonCopyable
+    {
+    private:
+        struct Record
+        {
+            std::uint64_t source_hash;
+            std::int64_t mtime;
+            std::uint64_t size;
+            std::uint32_t importer;
+            file::FileType type;
+        };
+
+        std::filesystem::path m_root;
+
+        /** Index as of the last flush */
+        file::MappedFile m_index {};
+        std::span<CacheRecord const> m_records {};
+        std::string_view m_names {};
+
+        /** Records changed since the last flush */
+        std::unordered_map<std::string, Record> m_updates {};
+
+        auto map_index() -> void;
+        [[nodiscard]] auto mapped(std::string_view key) const noexcept -> CacheRecord const *;
+        [[nodiscard]] auto record(std::string const &key) const -> std::optional<Record>;
+        [[nodiscard]] auto blob_path(std::uint64_t source_hash, std::uint32_t importer) const -> std::filesystem::path;
+
+    public:
+        /** Opens or creates the cache in `root`, an unreadable index starts it cold */
+        explicit AssetCache(std::filesystem::path root);
+        ~AssetCache();
+
+        AssetCache(AssetCache &&)                    = delete;
+        auto operator=(AssetCache &&) -> AssetCache & = delete;
+
+        /** Maps the blob processed from `source` by `importer`, if still up to date */
+        [[nodiscard]] auto find(std::filesystem::path const &source, std::uint32_t importer)
+            -> std::optional<CachedAsset>;
+
+        /** Stores `data` as processed from `source` by `importer`, throws on I/O errors */
+        auto store(std::filesystem::path const &source, std::uint32_t importer, memory::BufferRef data) -> void;
+
+        /** Writes pending records to the index, throws on I/O errors */
+        auto flush() -> void;
+
+        /** Flushes, then removes blobs no record points to, returns how many */
+        auto prune() -> usize;
+
+        /** Amount of sources recorded */
+        [[nodiscard]] auto size() const -> usize;
+    };
+}  // namespace assets::io
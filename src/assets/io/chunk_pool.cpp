@@ -0,0 +1,173 @@
+/** @file chunk_pool.cpp */
+
+// module includes
+#include "chunk_pool.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <utility>
+
+
+namespace assets::io
+{
+    // ============================================================================================== //
+    // ChunkJob implementation ====================================================================== //
+    // ============================================================================================== //
+
+    ChunkJob::ChunkJob(usize count, std::function<void(usize)> task)
+      : m_task { std::move(task) }, m_count { count }, m_done { std::make_unique<std::atomic<bool>[]>(count) }
+    {
+    }
+
+    auto ChunkJob::run_one() -> bool
+    {
+        auto index = m_next.fetch_add(1U, std::memory_order_relaxed);
+        if (index >= m_count) {
+            return (false);
+        }
+
+        std::exception_ptr failure {};
+
+        if (!m_failed.load(std::memory_order_relaxed)) {
+            try {
+                m_task(index);
+            } catch (...) {
+                failure = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> guard { m_lock };
+
+            if (failure && !m_error) {
+                m_error = failure;
+                m_failed.store(true, std::memory_order_relaxed);
+            }
+
+            m_done[index].store(true, std::memory_order_release);
+        }
+
+        m_finished.notify_all();
+        return (true);
+    }
+
+    auto ChunkJob::wait(usize index) -> void
+    {
+        while (!m_done[index].load(std::memory_order_acquire)) {
+            if (this->run_one()) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> guard { m_lock };
+            m_finished.wait(guard, [&] { return (m_done[index].load(std::memory_order_acquire)); });
+        }
+    }
+
+    auto ChunkJob::wait() -> void
+    {
+        for (auto index = usize { 0U }; index < m_count; ++index) {
+            this->wait(index);
+        }
+    }
+
+    auto ChunkJob::rethrow() -> void
+    {
+        std::lock_guard<std::mutex> guard { m_lock };
+
+        if (m_error) {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+    auto ChunkJob::cancel() noexcept -> void
+    {
+        m_failed.store(true, std::memory_order_relaxed);
+    }
+
+    auto ChunkJob::failed() const noexcept -> bool
+    {
+        return (m_failed.load(std::memory_order_relaxed));
+    }
+
+    auto ChunkJob::size() const noexcept -> usize
+    {
+        return (m_count);
+    }
+
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    ChunkPool::ChunkPool(): ChunkPool { std::max(usize { std::thread::hardware_concurrency() }, usize { 1U }) - 1U }
+    {
+    }
+
+    ChunkPool::ChunkPool(usize threads)
+    {
+        m_workers.reserve(threads);
+
+        for (auto i = usize { 0U }; i < threads; ++i) {
+            m_workers.emplace_back([this] { this->worker(); });
+        }
+    }
+
+    ChunkPool::~ChunkPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_lock };
+            m_stopping = true;
+        }
+
+        m_ready.notify_all();
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    // ============================================================================================== //
+    // ChunkPool implementation ===================================================================== //
+    // ============================================================================================== //
+
+    auto ChunkPool::worker() -> void
+    {
+        while (true) {
+            std::unique_lock<std::mutex> lock { m_lock };
+            m_ready.wait(lock, [this] { return (m_stopping || !m_jobs.empty()); });
+
+            if (m_stopping) {
+                return;
+            }
+
+            auto job = m_jobs.front();
+            lock.unlock();
+
+            while (job->run_one()) {
+            }
+
+            // every chunk is claimed, whoever notices first retires the job
+            lock.lock();
+            if (!m_jobs.empty() && (m_jobs.front() == job)) {
+                m_jobs.pop_front();
+            }
+        }
+    }
+
+    auto ChunkPool::start(std::shared_ptr<ChunkJob> const &job) -> void
+    {
+        if (m_workers.empty() || (job->size() < 2U)) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock { m_lock };
+            m_jobs.push_back(job);
+        }
+
+        m_ready.notify_all();
+    }
+
+    auto ChunkPool::workers() const noexcept -> usize
+    {
+        return (m_workers.size());
+    }
+}  // namespace assets::io
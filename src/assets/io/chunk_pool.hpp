@@ -0,0 +1,99 @@
+/** @file chunk_pool.hpp */
+
+#pragma once
+
+// module includes
+#include "util/util.hpp"
+
+// c++ includes
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace assets::io
+{
+    /**
+     * Work split into chunks, claimed one at a time by whoever runs it
+     *
+     * Once a chunk throws, chunks claimed afterwards are skipped and the
+     * first exception is kept for `rethrow()`.
+     */
+    class ChunkJob: private NonCopyable
+    {
+    private:
+        std::function<void(usize)> m_task;
+        usize m_count;
+
+        std::atomic<usize> m_next { 0U };
+        std::unique_ptr<std::atomic<bool>[]> m_done;
+        std::atomic<bool> m_failed { false };
+        std::exception_ptr m_error {};
+
+        std::mutex m_lock {};
+        std::condition_variable m_finished {};
+
+    public:
+        /** Runs `task(index)` for every index below `count` */
+        ChunkJob(usize count, std::function<void(usize)> task);
+
+        ChunkJob(ChunkJob &&)                    = delete;
+        auto operator=(ChunkJob &&) -> ChunkJob & = delete;
+
+        /** Runs the next unclaimed chunk, false once all are claimed */
+        auto run_one() -> bool;
+
+        /** Waits for chunk `index`, running others meanwhile */
+        auto wait(usize index) -> void;
+
+        /** Waits for every chunk */
+        auto wait() -> void;
+
+        /** Throws the first failure, if any */
+        auto rethrow() -> void;
+
+        /** Skips every chunk not claimed yet */
+        auto cancel() noexcept -> void;
+
+        [[nodiscard]] auto failed() const noexcept -> bool;
+        [[nodiscard]] auto size() const noexcept -> usize;
+    };
+
+    /**
+     * Workers helping callers through their `ChunkJob`s
+     *
+     * Callers run their own jobs as well, so a pool without workers runs
+     * them sequentially. Jobs are taken in order of arrival.
+     */
+    class ChunkPool: private NonCopyable
+    {
+    private:
+        std::vector<std::thread> m_workers {};
+        std::deque<std::shared_ptr<ChunkJob>> m_jobs {};
+        std::mutex m_lock {};
+        std::condition_variable m_ready {};
+        bool m_stopping { false };
+
+        auto worker() -> void;
+
+    public:
+        /** One worker less than hardware threads, the caller being the last one */
+        ChunkPool();
+        explicit ChunkPool(usize threads);
+        ~ChunkPool();
+
+        ChunkPool(ChunkPool &&)                    = delete;
+        auto operator=(ChunkPool &&) -> ChunkPool & = delete;
+
+        /** Hands `job` to the workers, a single chunk is left to the caller */
+        auto start(std::shared_ptr<ChunkJob> const &job) -> void;
+
+        [[nodiscard]] auto workers() const noexcept -> usize;
+    };
+}  // namespace assets::io
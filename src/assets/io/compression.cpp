@@ -0,0 +1,331 @@
+/** @file compression.cpp */
+
+// module includes
+#include "compression.hpp"
+#include "lz4.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// codec includes
+#if defined(WORMING_HAS_ZSTD)
+#include <zstd.h>
+#endif
+
+// logging
+#include "spdlog/spdlog.h"
+
+
+namespace assets::io
+{
+    namespace
+    {
+        /** zstd level trading ratio for build time, decoding speed barely depends on it */
+        i32 static constexpr const ZSTD_LEVEL = { 9 };
+
+        auto chunk_bound(Compression codec, usize size) noexcept -> usize
+        {
+            switch (codec) {
+            case Compression::Lz4: {
+                return (lz4::compress_bound(size));
+            }
+#if defined(WORMING_HAS_ZSTD)
+            case Compression::Zstd: {
+                return (ZSTD_compressBound(size));
+            }
+#endif
+            default: {
+                return (size);
+            }
+            }
+        }
+
+        /** Compressed size, zero if the chunk does not shrink */
+        auto encode_chunk(Compression codec, memory::BufferRef src, memory::BufferRef dst) noexcept -> usize
+        {
+            auto size = usize { 0U };
+
+            switch (codec) {
+            case Compression::Lz4: {
+                size = lz4::compress(src, dst);
+            } break;
+#if defined(WORMING_HAS_ZSTD)
+            case Compression::Zstd: {
+                auto result = ZSTD_compress(dst.data(), dst.length(), src.data(), src.length(), ZSTD_LEVEL);
+                size        = ZSTD_isError(result) ? 0U : result;
+            } break;
+#endif
+            default: {
+            } break;
+            }
+
+            return ((size < src.length()) ? size : 0U);
+        }
+
+        /** Whether `src` decoded to exactly `dst.length()` bytes */
+        auto decode_chunk(Compression codec, memory::BufferRef src, memory::BufferRef dst) noexcept -> bool
+        {
+            switch (codec) {
+            case Compression::Lz4: {
+                return (lz4::decompress(src, dst) == static_cast<isize>(dst.length()));
+            }
+#if defined(WORMING_HAS_ZSTD)
+            case Compression::Zstd: {
+                auto result = ZSTD_decompress(dst.data(), dst.length(), src.data(), src.length());
+                return (!ZSTD_isError(result) && (result == dst.length()));
+            }
+#endif
+            default: {
+                return (false);
+            }
+            }
+        }
+
+        [[noreturn]] auto malformed(std::string_view reason) -> void
+        {
+            spdlog::error(fmt::format("IO/ERROR: Malformed compressed payload, {}", reason));
+            throw std::runtime_error("Malformed compressed payload");
+        }
+
+        auto read_header(memory::BufferRef src) -> ChunkedHeader
+        {
+            if (src.length() < sizeof(ChunkedHeader)) {
+                malformed("truncated header");
+            }
+
+            ChunkedHeader header {};
+            std::memcpy(&header, src.data(), sizeof(header));
+
+            if (header.magic != CHUNKED_MAGIC) {
+                malformed("bad magic");
+            }
+
+            if (!codec_available(static_cast<Compression>(header.codec))) {
+                malformed(fmt::format("codec {} unavailable", header.codec));
+            }
+
+            if ((header.chunk_size == 0U) && (header.raw_size != 0U)) {
+                malformed("zero chunk size");
+            }
+
+            // rounded up without `raw_size + chunk_size`, which a hostile header overflows
+            auto expected = (header.raw_size == 0U) ? std::uint64_t { 0U }
+                                                    : (((header.raw_size - 1U) / header.chunk_size) + 1U);
+            if (header.count != expected) {
+                malformed("chunk count mismatch");
+            }
+
+            return (header);
+        }
+    }  // namespace
+
+    /** Chunks of a single call, located in the source and the destination */
+    struct Decompressor::Payload
+    {
+        struct Chunk
+        {
+            memory::BufferRef src;
+            memory::BufferRef dst;
+            bool stored;
+        };
+
+        Compression codec;
+        std::vector<Chunk> chunks;
+        std::uint64_t raw_size;
+    };
+
+    // ============================================================================================== //
+    // Encoding ===================================================================================== //
+    // ============================================================================================== //
+
+    auto codec_available(Compression codec) noexcept -> bool
+    {
+        switch (codec) {
+        case Compression::None:
+        case Compression::Lz4: {
+            return (true);
+        }
+        case Compression::Zstd: {
+#if defined(WORMING_HAS_ZSTD)
+            return (true);
+#else
+            return (false);
+#endif
+        }
+        }
+
+        return (false);
+    }
+
+    auto compress(Compression codec, memory::BufferRef src, usize chunk_size) -> std::vector<std::uint8_t>
+    {
+        if (!codec_available(codec)) {
+            spdlog::error(fmt::format("IO/ERROR: Compression codec {} is unavailable in this build",
+                                      static_cast<std::uint16_t>(codec)));
+            throw std::runtime_error("Unavailable compression codec");
+        }
+
+        if ((chunk_size == 0U) || (chunk_size >= CHUNK_STORED)) {
+            spdlog::error(fmt::format("IO/ERROR: Invalid chunk size {}", chunk_size));
+            throw std::runtime_error("Invalid chunk size");
+        }
+
+        ChunkedHeader header {};
+        header.magic      = CHUNKED_MAGIC;
+        header.codec      = static_cast<std::uint16_t>(codec);
+        header.chunk_size = static_cast<std::uint32_t>(chunk_size);
+        header.count      = static_cast<std::uint32_t>((src.length() + chunk_size - 1U) / chunk_size);
+        header.raw_size   = src.length();
+
+        auto table_size = header.count * sizeof(std::uint32_t);
+
+        std::vector<std::uint8_t> result(sizeof(header) + table_size);
+        std::vector<std::uint8_t> scratch(chunk_bound(codec, chunk_size));
+        std::vector<std::uint32_t> sizes {};
+        sizes.reserve(header.count);
+
+        for (auto offset = usize { 0U }; offset < src.length(); offset += chunk_size) {
+            auto chunk = src.subview(offset, std::min(chunk_size, src.length() - offset));
+            auto size  = encode_chunk(codec, chunk, memory::BufferRef { scratch.data(), scratch.size() });
+
+            auto const *data = static_cast<std::uint8_t const *>(chunk.data());
+            if (size == 0U) {
+                sizes.push_back(static_cast<std::uint32_t>(chunk.length()) | CHUNK_STORED);
+                result.insert(result.end(), data, data + chunk.length());
+            } else {
+                sizes.push_back(static_cast<std::uint32_t>(size));
+                result.insert(result.end(), scratch.data(), scratch.data() + size);
+            }
+        }
+
+        std::memcpy(result.data(), &header, sizeof(header));
+        if (table_size > 0U) {
+            std::memcpy(result.data() + sizeof(header), sizes.data(), table_size);
+        }
+
+        return (result);
+    }
+
+    auto decompressed_size(memory::BufferRef src) -> usize
+    {
+        return (static_cast<usize>(read_header(src).raw_size));
+    }
+
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    Decompressor::Decompressor() = default;
+
+    Decompressor::Decompressor(usize threads): m_pool { threads }
+    {
+    }
+
+    Decompressor::~Decompressor() = default;
+
+    // ============================================================================================== //
+    // Decoding ===================================================================================== //
+    // ============================================================================================== //
+
+    auto Decompressor::prepare(memory::BufferRef src, memory::BufferRef dst) -> Payload
+    {
+        auto header = read_header(src);
+
+        if (dst.length() < header.raw_size) {
+            malformed(fmt::format("{} bytes do not fit {} bytes", header.raw_size, dst.length()));
+        }
+
+        // the table is checked first, so that a hostile count allocates nothing
+        auto table  = src.subview(sizeof(header));
+        auto offset = sizeof(header) + (header.count * sizeof(std::uint32_t));
+        if (offset > src.length()) {
+            malformed("truncated chunk table");
+        }
+
+        Payload payload {};
+        payload.codec    = static_cast<Compression>(header.codec);
+        payload.raw_size = header.raw_size;
+        payload.chunks.reserve(header.count);
+
+        for (auto index = usize { 0U }; index < header.count; ++index) {
+            std::uint32_t size {};
+            std::memcpy(&size, static_cast<std::uint8_t const *>(table.data()) + (index * sizeof(size)), sizeof(size));
+
+            auto raw_offset = index * header.chunk_size;
+            auto raw_length = std::min<usize>(header.chunk_size, header.raw_size - raw_offset);
+            auto stored     = (size & CHUNK_STORED) != 0U;
+            auto length     = static_cast<usize>(size & ~CHUNK_STORED);
+
+            if ((length > (src.length() - offset)) || (stored && (length != raw_length))) {
+                malformed("chunk out of bounds");
+            }
+
+            payload.chunks.push_back(
+                Payload::Chunk { src.subview(offset, length), dst.subview(raw_offset, raw_length), stored });
+            offset += length;
+        }
+
+        return (payload);
+    }
+
+    auto Decompressor::decompress(memory::BufferRef src, memory::BufferRef dst) -> usize
+    {
+        return (this->stream(src, dst, [](memory::BufferRef /*chunk*/) {}));
+    }
+
+    auto Decompressor::stream(memory::BufferRef src, memory::BufferRef dst,
+                              std::function<void(memory::BufferRef)> const &on_chunk) -> usize
+    {
+        auto payload = prepare(src, dst);
+        auto job     = std::make_shared<ChunkJob>(payload.chunks.size(), [&payload](usize index) -> void {
+            auto const &chunk = payload.chunks[index];
+
+            if (chunk.stored) {
+                std::memcpy(chunk.dst.data(), chunk.src.data(), chunk.dst.length());
+            } else if (!decode_chunk(payload.codec, chunk.src, chunk.dst)) {
+                throw std::runtime_error("Corrupted chunk");
+            }
+        });
+
+        m_pool.start(job);
+
+        auto total = usize { 0U };
+        auto index = usize { 0U };
+
+        // every chunk has to be waited for, workers may still write into `dst`
+        SCOPE_FAIL
+        {
+            job->cancel();
+
+            for (; index < job->size(); ++index) {
+                job->wait(index);
+            }
+        };
+
+        for (; index < job->size(); ++index) {
+            job->wait(index);
+
+            if (!job->failed()) {
+                on_chunk(payload.chunks[index].dst);
+                total += payload.chunks[index].dst.length();
+            }
+        }
+
+        if (job->failed()) {
+            malformed("corrupted chunk");
+        }
+
+        if (total != payload.raw_size) {
+            malformed(fmt::format("{} bytes decoded out of {}", total, payload.raw_size));
+        }
+
+        return (total);
+    }
+
+    auto Decompressor::workers() const noexcept -> usize
+    {
+        return (m_pool.workers());
+    }
+}  // namespace assets::io
@@ -0,0 +1,122 @@
+/** @file compression.hpp */
+
+#pragma once
+
+// module includes
+#include "chunk_pool.hpp"
+#include "memory/block.hpp"
+#include "memory/buffer_ref.hpp"
+#include "util/util.hpp"
+
+// c++ includes
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+
+namespace assets::io
+{
+    /** Codec of a stored payload */
+    enum class Compression : std::uint16_t
+    {
+        None = 0,
+        /** In-tree LZ4 block codec, always available */
+        Lz4,
+        /** Requires the build to find `libzstd` */
+        Zstd,
+    };
+
+    /**
+     * Leading bytes of a compressed payload
+     *
+     * The payload is cut into `chunk_size` chunks compressed independently
+     * of each other. The header is followed by the compressed size of every
+     * chunk, then by the chunks themselves. Chunks which did not shrink are
+     * stored as is and flagged with `CHUNK_STORED`.
+     */
+    struct ChunkedHeader
+    {
+        std::array<char, 4> magic;
+        /** `Compression` of the chunks */
+        std::uint16_t codec;
+        std::uint16_t reserved;
+        std::uint32_t chunk_size;
+        std::uint32_t count;
+        std::uint64_t raw_size;
+    };
+
+    static_assert(sizeof(ChunkedHeader) == 24U, "chunked header layout is part of the format");
+
+    std::array<char, 4> static constexpr const CHUNKED_MAGIC = { 'W', 'C', 'H', 'K' };
+    std::uint32_t static constexpr const CHUNK_STORED        = { 1U << 31U };
+    usize static constexpr const DEFAULT_CHUNK_SIZE          = { 256U * 1024U };
+
+    /** Whether this build can encode and decode `codec` */
+    [[nodiscard]] auto codec_available(Compression codec) noexcept -> bool;
+
+    /** Compresses `src` into a chunked payload, throws if `codec` is unavailable */
+    [[nodiscard]] auto compress(Compression codec, memory::BufferRef src, usize chunk_size = DEFAULT_CHUNK_SIZE)
+        -> std::vector<std::uint8_t>;
+
+    /** Size of a chunked payload once decompressed, throws if malformed */
+    [[nodiscard]] auto decompressed_size(memory::BufferRef src) -> usize;
+
+    /**
+     * Decompresses chunked payloads on a pool of workers
+     *
+     * The calling thread decodes chunks too, so a pool without workers
+     * decodes sequentially. Malformed payloads throw once every chunk
+     * already claimed by a worker is done with the destination.
+     */
+    class Decompressor: private NonCopyable
+    {
+    private:
+        struct Payload;
+
+        ChunkPool m_pool;
+
+        auto static prepare(memory::BufferRef src, memory::BufferRef dst) -> Payload;
+
+    public:
+        /** One worker less than hardware threads, the caller being the last one */
+        Decompressor();
+        explicit Decompressor(usize threads);
+        ~Decompressor();
+
+        Decompressor(Decompressor &&)                    = delete;
+        auto operator=(Decompressor &&) -> Decompressor & = delete;
+
+        /** Decompresses `src` into `dst`, returns the decompressed size */
+        auto decompress(memory::BufferRef src, memory::BufferRef dst) -> usize;
+
+        /** Decompresses `src` into memory from `arena`, `null_block` if it is exhausted */
+        template <IsAllocator Allocator>
+        auto decompress(Allocator &arena, memory::BufferRef src) -> memory::Block
+        {
+            auto block = arena.alloc(decompressed_size(src));
+            if (block == memory::null_block) {
+                return (memory::null_block);
+            }
+
+            SCOPE_FAIL
+            {
+                arena.free(block);
+            };
+
+            this->decompress(src, memory::BufferRef { block });
+            return (block);
+        }
+
+        /**
+         * Decompresses `src` into `dst`, handing chunks to `on_chunk` in order
+         *
+         * A chunk is handed over as soon as it and every chunk before it are
+         * decoded, while the workers carry on with the next ones.
+         */
+        auto stream(memory::BufferRef src, memory::BufferRef dst,
+                    std::function<void(memory::BufferRef)> const &on_chunk) -> usize;
+
+        [[nodiscard]] auto workers() const noexcept -> usize;
+    };
+}  // namespace assets::io
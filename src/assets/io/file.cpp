@@ -3,6 +3,10 @@
 // module includes
 #include "file.hpp"
 
+// c++ includes
+#include <iterator>
+#include <string_view>
+
 // logging
 #include "spdlog/spdlog.h"
 
@@ -49,11 +53,9 @@ namespace assets::io::file
         return (m_mode);
     }
 
-    auto File::type_from_ext() const -> FileType
+    auto type_from_path(std::string_view path) -> FileType
     {
-        using namespace util::literals;
-
-        auto ext  = m_path.substr(m_path.find_last_of('.') + 1);
+        auto ext  = path.substr(path.find_last_of('.') + 1);
         auto hash = util::string::hash_str(ext);
         for (const auto &[key, val] : details::FILETYPES_ASSOC) {
             if (std::find(val.cbegin(), val.cend(), hash) != val.cend()) {
@@ -64,6 +66,11 @@ namespace assets::io::file
         return (FileType::PlainText);
     }
 
+    auto File::type_from_ext() const -> FileType
+    {
+        return (type_from_path(m_path));
+    }
+
     auto File::set_mode(Mode mode) -> void
     {
         m_mode = mode;
@@ -102,9 +109,15 @@ namespace assets::io::file
     {
         std::vector<std::string> result {};
 
-        std::string line {};
-        while (std::getline(m_handle, line)) {
-            result.push_back(line);
+        // one read for the whole stream, lines are then split as `std::getline` would, `\r` included
+        std::string contents { std::istreambuf_iterator<char> { m_handle }, std::istreambuf_iterator<char> {} };
+        std::string_view rest { contents };
+
+        while (!rest.empty()) {
+            auto end = rest.find('\n');
+            result.emplace_back(rest.substr(0U, end));
+
+            rest = (end == std::string_view::npos) ? std::string_view {} : rest.substr(end + 1U);
         }
 
         return (result);
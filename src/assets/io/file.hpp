@@ -61,6 +61,9 @@ namespace assets::io::file
         // clang-format on
     }  // namespace details
 
+    /** Classifies `path` by its extension, plain text when unknown */
+    [[nodiscard]] auto type_from_path(std::string_view path) -> FileType;
+
     class File
     {
     private:
@@ -99,6 +102,7 @@ namespace assets::io::file
 
         auto open() -> void;
 
+        /** Copies every line out, `TextParser` tokenizes mapped files without copies */
         auto read_lines() -> std::vector<std::string>;
 
         auto close() -> void;
@@ -0,0 +1,332 @@
+/** @file file_watcher.cpp */
+
+// module includes
+#include "file_watcher.hpp"
+#include "asset_cache.hpp"
+#include "mapped_file.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+// platform includes
+// clang-format off
+#if defined(__linux__)
+    #include <poll.h>
+    #include <sys/eventfd.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+// clang-format on
+
+// logging
+#include "spdlog/spdlog.h"
+
+
+namespace assets::io
+{
+    namespace
+    {
+#if defined(__linux__)
+        u32 static constexpr const WATCH_MASK = { IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_FROM
+                                                  | IN_MOVED_TO | IN_ONLYDIR };
+#endif
+
+        auto hash_file(std::string const &path) -> std::optional<std::uint64_t>
+        {
+            std::error_code error {};
+            if (!std::filesystem::is_regular_file(path, error)) {
+                return (std::nullopt);
+            }
+
+            try {
+                file::MappedFile contents { path, file::MapHint::Sequential };
+                return (content_hash(contents.view()));
+            } catch (std::exception const &) {
+                // removed or replaced while settling, its next event tells
+                return (std::nullopt);
+            }
+        }
+    }  // namespace
+
+    ReloadEvent::ReloadEvent(FileChange change)
+      : event::Event { event::EventType::LoadResource }, m_change { std::move(change) }
+    {
+    }
+
+    auto ReloadEvent::change() const noexcept -> FileChange const &
+    {
+        return (m_change);
+    }
+
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    FileWatcher::FileWatcher(std::chrono::milliseconds settle): m_settle { settle }
+    {
+#if defined(__linux__)
+        m_inotify = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        m_wake    = ::eventfd(0U, EFD_CLOEXEC);
+
+        if ((m_inotify < 0) || (m_wake < 0)) {
+            spdlog::error(fmt::format("IO/ERROR: File watcher could not be started, errno {}", errno));
+
+            if (m_inotify >= 0) {
+                ::close(m_inotify);
+            }
+
+            if (m_wake >= 0) {
+                ::close(m_wake);
+            }
+
+            throw std::runtime_error("Cannot start file watcher");
+        }
+
+        m_thread = std::thread { [this] { this->run(); } };
+#else
+        spdlog::error(fmt::format("IO/ERROR: File watching is only implemented on linux"));
+        throw std::runtime_error("Cannot start file watcher");
+#endif
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+#if defined(__linux__)
+        std::uint64_t stop { 1U };
+        [[maybe_unused]] auto written = ::write(m_wake, &stop, sizeof(stop));
+
+        m_thread.join();
+
+        ::close(m_wake);
+        ::close(m_inotify);
+#endif
+    }
+
+    // ============================================================================================== //
+    // Watcher thread =============================================================================== //
+    // ============================================================================================== //
+
+    auto FileWatcher::run() -> void
+    {
+#if defined(__linux__)
+        std::array<pollfd, 2> fds = { { { m_inotify, POLLIN, 0 }, { m_wake, POLLIN, 0 } } };
+        auto timeout              = std::chrono::milliseconds { -1 };
+
+        while (true) {
+            if ((::poll(fds.data(), fds.size(), static_cast<int>(timeout.count())) < 0) && (errno != EINTR)) {
+                spdlog::error(fmt::format("IO/ERROR: File watcher stopped, errno {}", errno));
+                return;
+            }
+
+            if ((fds[1].revents & POLLIN) != 0) {
+                return;
+            }
+
+            if ((fds[0].revents & POLLIN) != 0) {
+                this->read_events();
+            }
+
+            timeout = this->settle();
+        }
+#endif
+    }
+
+    auto FileWatcher::read_events() -> void
+    {
+#if defined(__linux__)
+        alignas(inotify_event) std::array<char, 16384> buffer {};
+
+        while (true) {
+            auto length = ::read(m_inotify, buffer.data(), buffer.size());
+            if (length <= 0) {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock { m_watch_lock };
+
+            for (auto offset = isize { 0 }; offset < length;) {
+                inotify_event const *event = reinterpret_cast<inotify_event const *>(buffer.data() + offset);
+                offset += static_cast<isize>(sizeof(inotify_event) + event->len);
+
+                if ((event->mask & IN_Q_OVERFLOW) != 0U) {
+                    spdlog::error(fmt::format("IO/ERROR: File watcher queue overflowed, changes were lost"));
+                    continue;
+                }
+
+                auto directory = m_directories.find(event->wd);
+                if (directory == m_directories.end()) {
+                    continue;
+                }
+
+                if ((event->mask & IN_IGNORED) != 0U) {
+                    m_directories.erase(directory);
+                    continue;
+                }
+
+                if (event->len == 0U) {
+                    continue;
+                }
+
+                auto path = directory->second / event->name;
+
+                if ((event->mask & IN_ISDIR) != 0U) {
+                    if ((event->mask & (IN_CREATE | IN_MOVED_TO)) != 0U) {
+                        try {
+                            this->add_directory(path, true);
+                        } catch (std::exception const &) {
+                            // already logged, the rest of the tree is still watched
+                        }
+                    }
+
+                    continue;
+                }
+
+                auto key = path.string();
+                if ((event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0U) {
+                    m_hashes.erase(key);
+                    m_dirty.erase(key);
+                } else {
+                    m_dirty[key] = Clock::now();
+                }
+            }
+        }
+#endif
+    }
+
+    auto FileWatcher::settle() -> std::chrono::milliseconds
+    {
+        auto now  = Clock::now();
+        auto next = std::chrono::milliseconds::max();
+
+        for (auto it = m_dirty.begin(); it != m_dirty.end();) {
+            auto ready = it->second + m_settle;
+            if (ready > now) {
+                next = std::min(next, std::chrono::ceil<std::chrono::milliseconds>(ready - now));
+                ++it;
+                continue;
+            }
+
+            auto path = it->first;
+            it        = m_dirty.erase(it);
+
+            auto hash = hash_file(path);
+            if (!hash) {
+                continue;
+            }
+
+            Callback importer {};
+            {
+                std::lock_guard<std::mutex> lock { m_watch_lock };
+
+                auto [known, inserted] = m_hashes.try_emplace(path, *hash);
+                if (!inserted && (known->second == *hash)) {
+                    continue;
+                }
+
+                known->second = *hash;
+                importer      = m_importer;
+            }
+
+            FileChange change { std::move(path), *hash };
+
+            if (importer) {
+                try {
+                    importer(change);
+                } catch (std::exception const &error) {
+                    spdlog::error(fmt::format("IO/ERROR: \'{}\' could not be re-imported, {}", change.path, error.what()));
+                }
+            }
+
+            std::lock_guard<std::mutex> lock { m_changes_lock };
+            m_changes.push_back(std::move(change));
+            m_pending.store(true, std::memory_order_release);
+        }
+
+        return ((next == std::chrono::milliseconds::max()) ? std::chrono::milliseconds { -1 } : next);
+    }
+
+    auto FileWatcher::add_directory(std::filesystem::path const &directory, bool mark_dirty) -> void
+    {
+#if defined(__linux__)
+        auto add = [this](std::filesystem::path const &path) -> void {
+            auto wd = ::inotify_add_watch(m_inotify, path.c_str(), WATCH_MASK);
+            if (wd < 0) {
+                spdlog::error(fmt::format("IO/ERROR: \'{}\' cannot be watched, errno {}", path.string(), errno));
+                throw std::runtime_error("Cannot watch directory");
+            }
+
+            m_directories[wd] = path;
+        };
+
+        add(directory);
+
+        auto options = std::filesystem::directory_options::skip_permission_denied;
+        for (auto const &entry : std::filesystem::recursive_directory_iterator { directory, options }) {
+            if (entry.is_directory()) {
+                add(entry.path());
+            } else if (entry.is_regular_file()) {
+                auto key = entry.path().string();
+
+                // files of a new directory were possibly written before it was watched
+                if (mark_dirty) {
+                    m_dirty[key] = Clock::now();
+                } else if (auto hash = hash_file(key)) {
+                    m_hashes[key] = *hash;
+                }
+            }
+        }
+#endif
+    }
+
+    // ============================================================================================== //
+    // FileWatcher implementation =================================================================== //
+    // ============================================================================================== //
+
+    auto FileWatcher::watch(std::filesystem::path const &root) -> void
+    {
+        if (!std::filesystem::is_directory(root)) {
+            spdlog::error(fmt::format("IO/ERROR: \'{}\' is not a directory", root.string()));
+            throw std::runtime_error("Cannot watch directory");
+        }
+
+        std::lock_guard<std::mutex> lock { m_watch_lock };
+        this->add_directory(root, false);
+    }
+
+    auto FileWatcher::set_importer(Callback importer) -> void
+    {
+        std::lock_guard<std::mutex> lock { m_watch_lock };
+        m_importer = std::move(importer);
+    }
+
+    auto FileWatcher::poll(Callback const &callback) -> usize
+    {
+        if (!m_pending.load(std::memory_order_acquire)) {
+            return (0U);
+        }
+
+        std::vector<FileChange> changes {};
+        {
+            std::lock_guard<std::mutex> lock { m_changes_lock };
+            changes.swap(m_changes);
+            m_pending.store(false, std::memory_order_relaxed);
+        }
+
+        for (auto const &change : changes) {
+            callback(change);
+        }
+
+        return (changes.size());
+    }
+
+    auto FileWatcher::watched() -> usize
+    {
+        std::lock_guard<std::mutex> lock { m_watch_lock };
+        return (m_directories.size());
+    }
+}  // namespace assets::io
@@ -0,0 +1,124 @@
+/** @file file_watcher.hpp */
+
+#pragma once
+
+// module includes
+#include "event/event.hpp"
+#include "util/util.hpp"
+
+// c++ includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+namespace assets::io
+{
+    /** File whose contents changed */
+    struct FileChange
+    {
+        std::string path;
+        /** `content_hash` of the new contents */
+        std::uint64_t hash;
+    };
+
+    /**
+     * `LoadResource` event carrying a changed file
+     */
+    class ReloadEvent: public event::Event
+    {
+    private:
+        FileChange m_change;
+
+    public:
+        explicit ReloadEvent(FileChange change);
+
+        [[nodiscard]] auto change() const noexcept -> FileChange const &;
+    };
+
+    /**
+     * Watches directory trees for modified files, linux only
+     *
+     * A thread sleeps on `inotify` and waits for a file to stay quiet for
+     * `settle` before hashing it, so a burst of writes is a single change.
+     * Files whose contents hash the same as before, e.g. saved unmodified,
+     * are not reported.
+     *
+     * Changed files are first handed to the importer on the watcher thread,
+     * e.g. `AssetManager::reload()`, then collected by `poll()` on the
+     * calling thread. Polling without changes reads one atomic flag.
+     */
+    class FileWatcher: private NonCopyable
+    {
+    public:
+        using Clock    = std::chrono::steady_clock;
+        using Callback = std::function<void(FileChange const &)>;
+
+    private:
+        std::chrono::milliseconds m_settle;
+
+        int m_inotify { -1 };
+        /** Wakes the thread up when stopping */
+        int m_wake { -1 };
+
+        /** Guards the watched directories and the known hashes */
+        std::mutex m_watch_lock {};
+        std::unordered_map<i32, std::filesystem::path> m_directories {};
+        std::unordered_map<std::string, std::uint64_t> m_hashes {};
+        Callback m_importer {};
+
+        /** Files written to, by time of their last write, watcher thread only */
+        std::unordered_map<std::string, Clock::time_point> m_dirty {};
+
+        std::vector<FileChange> m_changes {};
+        std::mutex m_changes_lock {};
+        std::atomic<bool> m_pending { false };
+
+        std::thread m_thread {};
+
+        auto run() -> void;
+        auto read_events() -> void;
+        /** Hashes files quiet for long enough, returns the time until the next one is */
+        auto settle() -> std::chrono::milliseconds;
+
+        /** Watches `directory` and its subdirectories, expects `m_watch_lock` held */
+        auto add_directory(std::filesystem::path const &directory, bool mark_dirty) -> void;
+
+    public:
+        /** @param settle time a file has to stay untouched before it is hashed */
+        explicit FileWatcher(std::chrono::milliseconds settle = std::chrono::milliseconds { 100 });
+        ~FileWatcher();
+
+        FileWatcher(FileWatcher &&)                    = delete;
+        auto operator=(FileWatcher &&) -> FileWatcher & = delete;
+
+        /** Watches every file under `root`, hashing them now, throws if it cannot be watched */
+        auto watch(std::filesystem::path const &root) -> void;
+
+        /** Re-imports changed files on the watcher thread, before they are polled */
+        auto set_importer(Callback importer) -> void;
+
+        /** Invokes `callback` for every change so far, without blocking */
+        auto poll(Callback const &callback) -> usize;
+
+        /** Dispatches every change so far as a `ReloadEvent` */
+        template <class Dispatcher>
+        requires requires(Dispatcher &dispatcher, event::Event const &event) { dispatcher.dispatch(event); }
+        auto poll_events(Dispatcher &dispatcher) -> usize
+        {
+            return (this->poll([&dispatcher](FileChange const &change) -> void {
+                dispatcher.dispatch(ReloadEvent { change });
+            }));
+        }
+
+        /** Amount of directories watched */
+        [[nodiscard]] auto watched() -> usize;
+    };
+}  // namespace assets::io
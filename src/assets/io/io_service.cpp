@@ -0,0 +1,643 @@
+/** @file io_service.cpp */
+
+// module includes
+#include "io_service.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// platform includes
+// clang-format off
+#if defined(__linux__)
+    #include <fcntl.h>
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+// clang-format on
+
+// logging
+#include "spdlog/spdlog.h"
+
+
+namespace assets::io::detail
+{
+#if defined(__linux__)
+    /**
+     * Minimal `io_uring` driver over the raw syscalls
+     *
+     * Only ever touched by the thread owning the `IoService`.
+     */
+    struct Ring
+    {
+        i32 fd { -1 };
+
+        void *sq_ptr { MAP_FAILED };
+        usize sq_size { 0U };
+        void *cq_ptr { MAP_FAILED };
+        usize cq_size { 0U };
+        io_uring_sqe *sqes { static_cast<io_uring_sqe *>(MAP_FAILED) };
+        usize sqes_size { 0U };
+
+        unsigned *sq_head { nullptr };
+        unsigned *sq_tail { nullptr };
+        unsigned *sq_array { nullptr };
+        unsigned sq_mask { 0U };
+        unsigned sq_entries { 0U };
+
+        unsigned *cq_head { nullptr };
+        unsigned *cq_tail { nullptr };
+        io_uring_cqe *cqes { nullptr };
+        unsigned cq_mask { 0U };
+
+        /** Entries written and not yet entered */
+        unsigned pending { 0U };
+
+        Ring()             = default;
+        Ring(Ring const &) = delete;
+        Ring(Ring &&)      = delete;
+
+        auto operator=(Ring const &) -> Ring & = delete;
+        auto operator=(Ring &&) -> Ring      & = delete;
+
+        ~Ring()
+        {
+            if (sqes != MAP_FAILED) {
+                ::munmap(sqes, sqes_size);
+            }
+
+            if ((cq_ptr != MAP_FAILED) && (cq_ptr != sq_ptr)) {
+                ::munmap(cq_ptr, cq_size);
+            }
+
+            if (sq_ptr != MAP_FAILED) {
+                ::munmap(sq_ptr, sq_size);
+            }
+
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+
+        auto setup(unsigned entries) -> bool
+        {
+            io_uring_params params {};
+
+            fd = static_cast<i32>(::syscall(__NR_io_uring_setup, entries, &params));
+            if (fd < 0) {
+                return (false);
+            }
+
+            sq_size = params.sq_off.array + (params.sq_entries * sizeof(unsigned));
+            cq_size = params.cq_off.cqes + (params.cq_entries * sizeof(io_uring_cqe));
+
+            auto single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0U;
+            if (single) {
+                sq_size = std::max(sq_size, cq_size);
+                cq_size = sq_size;
+            }
+
+            sq_ptr = ::mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                            IORING_OFF_SQ_RING);
+            if (sq_ptr == MAP_FAILED) {
+                return (false);
+            }
+
+            cq_ptr = single ? sq_ptr
+                            : ::mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                                     IORING_OFF_CQ_RING);
+            if (cq_ptr == MAP_FAILED) {
+                return (false);
+            }
+
+            sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            sqes      = static_cast<io_uring_sqe *>(
+                ::mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+            if (sqes == MAP_FAILED) {
+                return (false);
+            }
+
+            auto *sq   = static_cast<u8 *>(sq_ptr);
+            sq_head    = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+            sq_tail    = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+            sq_array   = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+            sq_mask    = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+            sq_entries = params.sq_entries;
+
+            auto *cq = static_cast<u8 *>(cq_ptr);
+            cq_head  = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+            cq_tail  = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+            cqes     = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+            cq_mask  = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+
+            return (true);
+        }
+
+        /** Whether the kernel implements every opcode of `ops`, false before 5.6 */
+        auto supports(std::initializer_list<u8> ops) const -> bool
+        {
+            auto constexpr const count = usize { 256U };
+
+            // the probe ends in a flexible array of per-opcode entries
+            std::vector<u8> storage(sizeof(io_uring_probe) + (count * sizeof(io_uring_probe_op)));
+            auto *probe = reinterpret_cast<io_uring_probe *>(storage.data());
+
+            if (::syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, count) < 0) {
+                return (false);
+            }
+
+            return (std::all_of(ops.begin(), ops.end(), [probe](u8 op) {
+                return ((op <= probe->last_op) && ((probe->ops[op].flags & IO_URING_OP_SUPPORTED) != 0U));
+            }));
+        }
+
+        /** Next free submission entry, `nullptr` if the ring is full */
+        auto next() noexcept -> io_uring_sqe *
+        {
+            auto head = std::atomic_ref<unsigned> { *sq_head }.load(std::memory_order_acquire);
+            auto tail = *sq_tail;
+
+            if ((tail - head) >= sq_entries) {
+                return (nullptr);
+            }
+
+            auto index      = tail & sq_mask;
+            sq_array[index] = index;
+
+            std::atomic_ref<unsigned> { *sq_tail }.store(tail + 1U, std::memory_order_release);
+            pending += 1U;
+
+            auto *sqe = &sqes[index];
+            *sqe      = io_uring_sqe {};
+
+            return (sqe);
+        }
+
+        /** Submits pending entries, optionally waiting for a completion */
+        auto enter(bool wait) noexcept -> void
+        {
+            auto flags = wait ? IORING_ENTER_GETEVENTS : 0U;
+
+            while (true) {
+                auto result = ::syscall(__NR_io_uring_enter, fd, pending, wait ? 1U : 0U, flags, nullptr, 0U);
+                if (result >= 0) {
+                    pending -= static_cast<unsigned>(result);
+                    return;
+                }
+
+                if (errno != EINTR) {
+                    return;
+                }
+            }
+        }
+
+        /** Walks available completions */
+        template <class F>
+        auto drain(F &&on_completion) -> void
+        {
+            auto head = *cq_head;
+            auto tail = std::atomic_ref<unsigned> { *cq_tail }.load(std::memory_order_acquire);
+
+            while (head != tail) {
+                auto cqe = cqes[head & cq_mask];
+                std::atomic_ref<unsigned> { *cq_head }.store(++head, std::memory_order_release);
+
+                on_completion(cqe);
+            }
+        }
+    };
+#else
+    struct Ring
+    {
+    };
+#endif
+}  // namespace assets::io::detail
+
+namespace assets::io
+{
+    // ============================================================================================== //
+    // LoadEvent implementation ===================================================================== //
+    // ============================================================================================== //
+
+    LoadEvent::LoadEvent(Completion completion)
+      : event::Event { event::EventType::LoadResource }, m_completion { std::move(completion) }
+    {
+    }
+
+    auto LoadEvent::completion() const noexcept -> Completion const &
+    {
+        return (m_completion);
+    }
+
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    IoService::IoService(usize depth, usize threads, IoBackend backend): m_depth { std::max(depth, usize { 1U }) }
+    {
+        if ((backend != IoBackend::ThreadPool) && this->start_ring()) {
+            m_backend = IoBackend::Ring;
+            return;
+        }
+
+        if (backend == IoBackend::Ring) {
+            spdlog::error("IO/ERROR: io_uring is not available");
+            throw std::runtime_error("Cannot set up io_uring");
+        }
+
+        this->start_pool(std::max(threads, usize { 1U }));
+    }
+
+    IoService::~IoService()
+    {
+        if (m_backend == IoBackend::ThreadPool) {
+            {
+                std::lock_guard<std::mutex> lock { m_jobs_lock };
+                m_stopping = true;
+            }
+
+            m_jobs_ready.notify_all();
+            for (auto &worker : m_workers) {
+                worker.join();
+            }
+
+            return;
+        }
+
+        // the kernel may still write into the buffers, let it finish first
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock { m_done_lock };
+                m_in_flight -= m_done.size();
+                m_done.clear();
+            }
+
+            if (m_in_flight == 0U) {
+                break;
+            }
+
+            this->reap(true);
+        }
+    }
+
+    // ============================================================================================== //
+    // Ring backend ================================================================================= //
+    // ============================================================================================== //
+
+    auto IoService::start_ring() -> bool
+    {
+#if defined(__linux__)
+        auto ring = CreateScope<detail::Ring>();
+        if (!ring->setup(static_cast<unsigned>(m_depth))) {
+            return (false);
+        }
+
+        // early kernels set up the ring but reject every read with -EINVAL
+        if (!ring->supports({ IORING_OP_OPENAT, IORING_OP_READ })) {
+            spdlog::warn("IO/WARN: io_uring lacks openat/read support, using the thread pool");
+            return (false);
+        }
+
+        m_ring = std::move(ring);
+        m_ops.resize(m_depth);
+        m_free_ops.reserve(m_depth);
+
+        for (auto index = m_depth; index > 0U; --index) {
+            m_free_ops.push_back(index - 1U);
+        }
+
+        return (true);
+#else
+        return (false);
+#endif
+    }
+
+    auto IoService::push_ring(u64 id, ReadRequest request) -> void
+    {
+#if defined(__linux__)
+        if (m_free_ops.empty()) {
+            m_backlog.emplace_back(id, std::move(request));
+            return;
+        }
+
+        auto index = m_free_ops.back();
+        m_free_ops.pop_back();
+
+        // opened on the ring as well, the read is issued once the descriptor is known
+        m_ops[index] = Op { std::move(request), id, -1, 0U };
+        this->issue(index);
+#else
+        (void)id;
+        (void)request;
+#endif
+    }
+
+    auto IoService::issue(usize index) -> void
+    {
+#if defined(__linux__)
+        auto &op = m_ops[index];
+
+        auto *sqe = m_ring->next();
+        if (sqe == nullptr) {
+            m_stalled.push_back(index);
+            return;
+        }
+
+        sqe->user_data = index;
+
+        if (op.fd < 0) {
+            sqe->opcode     = IORING_OP_OPENAT;
+            sqe->fd         = AT_FDCWD;
+            sqe->addr       = reinterpret_cast<uintptr>(op.request.path.c_str());
+            sqe->open_flags = O_RDONLY | O_CLOEXEC;
+            return;
+        }
+
+        // larger reads come back short and are issued again for the rest
+        auto left = std::min<usize>(op.request.buffer.length() - op.done, std::numeric_limits<unsigned>::max());
+
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd     = op.fd;
+        sqe->addr   = reinterpret_cast<uintptr>(static_cast<u8 *>(op.request.buffer.data()) + op.done);
+        sqe->len    = static_cast<unsigned>(left);
+        sqe->off    = op.request.offset + op.done;
+#else
+        (void)index;
+#endif
+    }
+
+    auto IoService::reap(bool wait) -> void
+    {
+#if defined(__linux__)
+        m_ring->enter(wait);
+
+        m_ring->drain([this](io_uring_cqe const &cqe) -> void {
+            auto index = static_cast<usize>(cqe.user_data);
+            auto &op   = m_ops[index];
+
+            if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+                this->issue(index);
+                return;
+            }
+
+            if (op.fd < 0) {
+                if (cqe.res < 0) {
+                    this->complete(Completion { op.id, std::move(op.request.path), memory::BufferRef {}, cqe.res });
+                    m_free_ops.push_back(index);
+                    return;
+                }
+
+                op.fd = cqe.res;
+                this->issue(index);
+                return;
+            }
+
+            // a short read is only final at the end of the file
+            if (cqe.res > 0) {
+                op.done += static_cast<usize>(cqe.res);
+
+                if (op.done < op.request.buffer.length()) {
+                    this->issue(index);
+                    return;
+                }
+            }
+
+            ::close(op.fd);
+
+            auto result = (cqe.res < 0) ? static_cast<isize>(cqe.res) : static_cast<isize>(op.done);
+            auto filled = (cqe.res < 0) ? memory::BufferRef {} : op.request.buffer.slice(op.done);
+
+            this->complete(Completion { op.id, std::move(op.request.path), filled, result });
+            m_free_ops.push_back(index);
+        });
+
+        // entries are only ever stalled behind pending ones, which the kernel takes here
+        if (!m_stalled.empty()) {
+            m_ring->enter(false);
+
+            for (auto index : std::exchange(m_stalled, {})) {
+                this->issue(index);
+            }
+        }
+
+        while (!m_free_ops.empty() && !m_backlog.empty()) {
+            auto [id, request] = std::move(m_backlog.front());
+            m_backlog.pop_front();
+
+            this->push_ring(id, std::move(request));
+        }
+
+        // reads issued while reaping have to reach the kernel too
+        if (m_ring->pending > 0U) {
+            m_ring->enter(false);
+        }
+#else
+        (void)wait;
+#endif
+    }
+
+    // ============================================================================================== //
+    // Thread pool backend ========================================================================== //
+    // ============================================================================================== //
+
+    auto IoService::start_pool(usize threads) -> void
+    {
+        m_backend = IoBackend::ThreadPool;
+        m_workers.reserve(threads);
+
+        for (auto i = usize { 0U }; i < threads; ++i) {
+            m_workers.emplace_back([this] { this->worker(); });
+        }
+    }
+
+    auto IoService::worker() -> void
+    {
+        while (true) {
+            std::unique_lock<std::mutex> lock { m_jobs_lock };
+            m_jobs_ready.wait(lock, [this] { return (m_stopping || !m_jobs.empty()); });
+
+            if (m_jobs.empty()) {
+                return;
+            }
+
+            auto [id, request] = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            lock.unlock();
+
+#if defined(__linux__)
+            auto fd = ::open(request.path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                this->complete(Completion { id, std::move(request.path), memory::BufferRef {}, -errno });
+                continue;
+            }
+
+            auto *data  = request.buffer.as_ptr<u8 *>();
+            auto length = request.buffer.length();
+            auto count  = usize { 0U };
+            auto error  = 0;
+
+            // same short read handling as the ring, stopping at end of file
+            while (count < length) {
+                auto result = ::pread(fd, data + count, length - count, static_cast<off_t>(request.offset + count));
+                if (result < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+
+                    error = errno;
+                    break;
+                }
+
+                if (result == 0) {
+                    break;
+                }
+
+                count += static_cast<usize>(result);
+            }
+
+            ::close(fd);
+
+            if (error != 0) {
+                this->complete(Completion { id, std::move(request.path), memory::BufferRef {}, -error });
+                continue;
+            }
+#else
+            std::ifstream file { request.path, std::ios::in | std::ios::binary };
+            if (!file) {
+                auto error = (errno != 0) ? errno : ENOENT;
+                this->complete(Completion { id, std::move(request.path), memory::BufferRef {}, -error });
+                continue;
+            }
+
+            file.seekg(static_cast<std::streamoff>(request.offset));
+            file.read(request.buffer.as_ptr<char *>(), static_cast<std::streamsize>(request.buffer.length()));
+
+            if (file.bad()) {
+                this->complete(Completion { id, std::move(request.path), memory::BufferRef {}, -EIO });
+                continue;
+            }
+
+            auto count = static_cast<usize>(std::max(file.gcount(), std::streamsize { 0 }));
+#endif
+            this->complete(
+                Completion { id, std::move(request.path), request.buffer.slice(count), static_cast<isize>(count) });
+        }
+    }
+
+    // ============================================================================================== //
+    // IoService implementation ===================================================================== //
+    // ============================================================================================== //
+
+    auto IoService::complete(Completion completion) -> void
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_done_lock };
+            m_done.push_back(std::move(completion));
+        }
+
+        m_done_ready.notify_one();
+    }
+
+    auto IoService::read(std::string_view path, memory::BufferRef buffer, usize offset) -> u64
+    {
+        auto id = m_next_id++;
+        m_queued.emplace_back(id, ReadRequest { std::string { path }, buffer, offset });
+
+        return (id);
+    }
+
+    auto IoService::submit() -> usize
+    {
+        auto count = m_queued.size();
+        if (count == 0U) {
+            return (0U);
+        }
+
+        m_in_flight += count;
+
+        if (m_backend == IoBackend::Ring) {
+            for (auto &[id, request] : m_queued) {
+                this->push_ring(id, std::move(request));
+            }
+
+            // one syscall for the whole batch
+            this->reap(false);
+        } else {
+            {
+                std::lock_guard<std::mutex> lock { m_jobs_lock };
+                for (auto &job : m_queued) {
+                    m_jobs.push_back(std::move(job));
+                }
+            }
+
+            m_jobs_ready.notify_all();
+        }
+
+        m_queued.clear();
+        return (count);
+    }
+
+    auto IoService::poll(Callback const &callback) -> usize
+    {
+        if (m_backend == IoBackend::Ring) {
+            this->reap(false);
+        }
+
+        std::vector<Completion> done {};
+        {
+            std::lock_guard<std::mutex> lock { m_done_lock };
+            done.swap(m_done);
+        }
+
+        m_in_flight -= done.size();
+
+        for (auto const &completion : done) {
+            callback(completion);
+        }
+
+        return (done.size());
+    }
+
+    auto IoService::wait(Callback const &callback) -> usize
+    {
+        this->submit();
+
+        auto count = usize { 0U };
+        while (m_in_flight > 0U) {
+            if (m_backend == IoBackend::Ring) {
+                std::unique_lock<std::mutex> lock { m_done_lock };
+                auto empty = m_done.empty();
+                lock.unlock();
+
+                if (empty) {
+                    this->reap(true);
+                }
+            } else {
+                std::unique_lock<std::mutex> lock { m_done_lock };
+                m_done_ready.wait(lock, [this] { return (!m_done.empty()); });
+            }
+
+            count += this->poll(callback);
+        }
+
+        return (count);
+    }
+
+    auto IoService::backend() const noexcept -> IoBackend
+    {
+        return (m_backend);
+    }
+
+    auto IoService::in_flight() const noexcept -> usize
+    {
+        return (m_in_flight);
+    }
+}  // namespace assets::io
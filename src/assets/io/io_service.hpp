@@ -0,0 +1,179 @@
+/** @file io_service.hpp */
+
+#pragma once
+
+// module includes
+#include "event/event.hpp"
+#include "memory/buffer_ref.hpp"
+#include "util/util.hpp"
+
+// c++ includes
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+
+namespace assets::io
+{
+    namespace detail
+    {
+        /** Submission and completion rings of the kernel, linux only */
+        struct Ring;
+    }  // namespace detail
+
+    /** Backend carrying out the reads */
+    enum class IoBackend
+    {
+        /** Ring if the kernel provides one, thread pool otherwise */
+        Auto,
+        Ring,
+        ThreadPool,
+    };
+
+    /** Read into a caller-provided buffer */
+    struct ReadRequest
+    {
+        std::string path;
+        /** Filled from `offset` on, must stay alive until completion */
+        memory::BufferRef buffer;
+        usize offset;
+    };
+
+    /** Outcome of a `ReadRequest` */
+    struct Completion
+    {
+        u64 id;
+        std::string path;
+        /** Part of the request buffer actually filled */
+        memory::BufferRef buffer;
+        /** Amount of bytes read, or a negated `errno` */
+        isize result;
+
+        [[nodiscard]] auto inline ok() const noexcept -> bool
+        {
+            return (result >= 0);
+        }
+    };
+
+    /**
+     * `LoadResource` event carrying a completion
+     */
+    class LoadEvent: public event::Event
+    {
+    private:
+        Completion m_completion;
+
+    public:
+        explicit LoadEvent(Completion completion);
+
+        [[nodiscard]] auto completion() const noexcept -> Completion const &;
+    };
+
+    /**
+     * Batched asynchronous file reads
+     *
+     * Reads are queued with `read()` and handed to the backend together by
+     * `submit()`. Completions are collected by `poll()` on the calling thread,
+     * so callbacks and events never run on I/O threads.
+     *
+     * The ring backend opens and reads files through `io_uring`, so that
+     * submitting never blocks on the file system. The thread pool backend
+     * does both on its workers.
+     */
+    class IoService: private NonCopyable
+    {
+    private:
+        using Callback = std::function<void(Completion const &)>;
+
+        /** Request in flight on the ring, opening while `fd` is negative */
+        struct Op
+        {
+            ReadRequest request;
+            u64 id;
+            i32 fd;
+            usize done;
+        };
+
+        IoBackend m_backend { IoBackend::ThreadPool };
+        usize m_depth;
+
+        u64 m_next_id { 1U };
+        std::vector<std::pair<u64, ReadRequest>> m_queued {};
+        usize m_in_flight { 0U };
+
+        // ring backend
+        Scope<detail::Ring> m_ring {};
+        std::vector<Op> m_ops {};
+        std::vector<usize> m_free_ops {};
+        std::deque<std::pair<u64, ReadRequest>> m_backlog {};
+        /** Ops which found the submission queue full, issued again once completions are reaped */
+        std::vector<usize> m_stalled {};
+
+        // thread pool backend
+        std::vector<std::thread> m_workers {};
+        std::deque<std::pair<u64, ReadRequest>> m_jobs {};
+        std::mutex m_jobs_lock {};
+        std::condition_variable m_jobs_ready {};
+        bool m_stopping { false };
+
+        // completions waiting for `poll()`
+        std::vector<Completion> m_done {};
+        std::mutex m_done_lock {};
+        std::condition_variable m_done_ready {};
+
+        auto start_ring() -> bool;
+        auto start_pool(usize threads) -> void;
+        auto worker() -> void;
+
+        auto push_ring(u64 id, ReadRequest request) -> void;
+        auto issue(usize index) -> void;
+        auto reap(bool wait) -> void;
+
+        auto complete(Completion completion) -> void;
+
+    public:
+        /**
+         * @param depth amount of reads in flight on the ring
+         * @param threads amount of workers of the thread pool
+         * @param backend backend to use, throws if unavailable
+         */
+        explicit IoService(usize depth = 64U, usize threads = 2U, IoBackend backend = IoBackend::Auto);
+        ~IoService();
+
+        IoService(IoService &&)                    = delete;
+        auto operator=(IoService &&) -> IoService & = delete;
+
+        /** Queues a read of `buffer.length()` bytes from `offset`, returns its id */
+        auto read(std::string_view path, memory::BufferRef buffer, usize offset = 0U) -> u64;
+
+        /** Hands every queued read to the backend at once */
+        auto submit() -> usize;
+
+        /** Invokes `callback` for every read completed so far, without blocking */
+        auto poll(Callback const &callback) -> usize;
+
+        /** Dispatches every read completed so far as a `LoadEvent` */
+        template <class Dispatcher>
+        requires requires(Dispatcher &dispatcher, event::Event const &event) { dispatcher.dispatch(event); }
+        auto poll_events(Dispatcher &dispatcher) -> usize
+        {
+            return (this->poll([&dispatcher](Completion const &completion) -> void {
+                dispatcher.dispatch(LoadEvent { completion });
+            }));
+        }
+
+        /** Submits the queue and blocks until every read completed */
+        auto wait(Callback const &callback) -> usize;
+
+        [[nodiscard]] auto backend() const noexcept -> IoBackend;
+
+        /** Reads submitted and not yet polled */
+        [[nodiscard]] auto in_flight() const noexcept -> usize;
+    };
+}  // namespace assets::io
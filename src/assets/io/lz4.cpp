@@ -0,0 +1,243 @@
+/** @file lz4.cpp */
+
+// module includes
+#include "lz4.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+
+namespace assets::io::lz4
+{
+    namespace
+    {
+        /** Shortest match the format can express */
+        usize static constexpr const MIN_MATCH = { 4U };
+        /** Trailing bytes always emitted as literals */
+        usize static constexpr const LAST_LITERALS = { 5U };
+        /** No match may start within this distance from the end */
+        usize static constexpr const MF_LIMIT = { 12U };
+        usize static constexpr const MAX_DISTANCE = { 65535U };
+
+        usize static constexpr const HASH_BITS = { 12U };
+
+        auto inline read32(std::uint8_t const *src) noexcept -> std::uint32_t
+        {
+            std::uint32_t value {};
+            std::memcpy(&value, src, sizeof(value));
+
+            return (value);
+        }
+
+        auto inline hash(std::uint32_t sequence) noexcept -> usize
+        {
+            return (static_cast<usize>((sequence * 2654435761U) >> (32U - HASH_BITS)));
+        }
+
+        /** Writes the 255-run extension of a length field */
+        auto inline write_length(std::uint8_t *&out, std::uint8_t const *end, usize length) noexcept -> bool
+        {
+            for (; length >= 255U; length -= 255U) {
+                if (out >= end) {
+                    return (false);
+                }
+
+                *out++ = 255U;
+            }
+
+            if (out >= end) {
+                return (false);
+            }
+
+            *out++ = static_cast<std::uint8_t>(length);
+            return (true);
+        }
+
+        /** Reads the 255-run extension of a length field */
+        auto inline read_length(std::uint8_t const *&in, std::uint8_t const *end, usize &length) noexcept -> bool
+        {
+            std::uint8_t byte { 255U };
+
+            while (byte == 255U) {
+                if (in >= end) {
+                    return (false);
+                }
+
+                byte = *in++;
+                length += byte;
+            }
+
+            return (true);
+        }
+
+        auto emit(std::uint8_t *&out, std::uint8_t const *end, std::uint8_t const *literals, usize literal_length,
+                  usize offset, usize match_length) noexcept -> bool
+        {
+            if (out >= end) {
+                return (false);
+            }
+
+            auto *token = out++;
+            *token      = static_cast<std::uint8_t>(std::min<usize>(literal_length, 15U) << 4U);
+
+            if ((literal_length >= 15U) && !write_length(out, end, literal_length - 15U)) {
+                return (false);
+            }
+
+            if (static_cast<usize>(end - out) < literal_length) {
+                return (false);
+            }
+
+            if (literal_length > 0U) {
+                std::memcpy(out, literals, literal_length);
+                out += literal_length;
+            }
+
+            // the last sequence only carries literals
+            if (match_length == 0U) {
+                return (true);
+            }
+
+            if ((end - out) < 2) {
+                return (false);
+            }
+
+            *out++ = static_cast<std::uint8_t>(offset & 0xFFU);
+            *out++ = static_cast<std::uint8_t>(offset >> 8U);
+
+            auto code = match_length - MIN_MATCH;
+            *token |= static_cast<std::uint8_t>(std::min<usize>(code, 15U));
+
+            return ((code < 15U) || write_length(out, end, code - 15U));
+        }
+    }  // namespace
+
+    auto compress_bound(usize size) noexcept -> usize
+    {
+        return (size + (size / 255U) + 16U);
+    }
+
+    auto compress(memory::BufferRef src, memory::BufferRef dst) noexcept -> usize
+    {
+        auto const *input = static_cast<std::uint8_t const *>(src.data());
+        auto size         = src.length();
+
+        auto *out       = static_cast<std::uint8_t *>(dst.data());
+        auto const *end = out + dst.length();
+
+        auto anchor = usize { 0U };
+
+        if (size > MF_LIMIT) {
+            // positions are stored off by one, zero marks an empty slot
+            std::array<std::uint32_t, usize { 1U } << HASH_BITS> table {};
+
+            auto match_limit = size - LAST_LITERALS;
+            auto search_end  = size - MF_LIMIT;
+            auto misses      = usize { 0U };
+
+            for (auto pos = usize { 0U }; pos < search_end;) {
+                auto sequence = read32(input + pos);
+                auto slot     = hash(sequence);
+                auto stored   = static_cast<usize>(table[slot]);
+
+                table[slot] = static_cast<std::uint32_t>(pos + 1U);
+
+                auto candidate = stored - 1U;
+                if ((stored == 0U) || ((pos - candidate) > MAX_DISTANCE) || (read32(input + candidate) != sequence)) {
+                    // incompressible input is skipped over faster and faster
+                    pos += 1U + (misses++ >> 6U);
+                    continue;
+                }
+
+                auto length = MIN_MATCH;
+                while (((pos + length) < match_limit) && (input[candidate + length] == input[pos + length])) {
+                    ++length;
+                }
+
+                if (!emit(out, end, input + anchor, pos - anchor, pos - candidate, length)) {
+                    return (0U);
+                }
+
+                pos += length;
+                anchor = pos;
+                misses = 0U;
+            }
+        }
+
+        if (!emit(out, end, input + anchor, size - anchor, 0U, 0U)) {
+            return (0U);
+        }
+
+        return (static_cast<usize>(out - static_cast<std::uint8_t *>(dst.data())));
+    }
+
+    auto decompress(memory::BufferRef src, memory::BufferRef dst) noexcept -> isize
+    {
+        auto const *in     = static_cast<std::uint8_t const *>(src.data());
+        auto const *in_end = in + src.length();
+
+        auto *const begin = static_cast<std::uint8_t *>(dst.data());
+        auto *out         = begin;
+        auto *const end   = begin + dst.length();
+
+        while (in < in_end) {
+            auto token = *in++;
+
+            auto literal_length = static_cast<usize>(token >> 4U);
+            if ((literal_length == 15U) && !read_length(in, in_end, literal_length)) {
+                return (-1);
+            }
+
+            if ((literal_length > static_cast<usize>(in_end - in)) || (literal_length > static_cast<usize>(end - out))) {
+                return (-1);
+            }
+
+            if (literal_length > 0U) {
+                std::memcpy(out, in, literal_length);
+                in += literal_length;
+                out += literal_length;
+            }
+
+            if (in == in_end) {
+                break;
+            }
+
+            if ((in_end - in) < 2) {
+                return (-1);
+            }
+
+            auto offset = static_cast<usize>(in[0]) | (static_cast<usize>(in[1]) << 8U);
+            in += 2;
+
+            if ((offset == 0U) || (offset > static_cast<usize>(out - begin))) {
+                return (-1);
+            }
+
+            auto match_length = static_cast<usize>(token & 0x0FU);
+            if ((match_length == 15U) && !read_length(in, in_end, match_length)) {
+                return (-1);
+            }
+
+            match_length += MIN_MATCH;
+            if (match_length > static_cast<usize>(end - out)) {
+                return (-1);
+            }
+
+            auto const *match = out - offset;
+            if (offset >= match_length) {
+                std::memcpy(out, match, match_length);
+                out += match_length;
+            } else {
+                // overlapping matches repeat the last `offset` bytes
+                for (auto i = usize { 0U }; i < match_length; ++i) {
+                    *out++ = match[i];
+                }
+            }
+        }
+
+        return (static_cast<isize>(out - begin));
+    }
+}  // namespace assets::io::lz4
@@ -0,0 +1,26 @@
+/** @file lz4.hpp
+ * In-tree codec for the LZ4 block format
+ *
+ * Blocks are compatible with the reference implementation, without its
+ * frame format. Compression is a single greedy pass, decompression checks
+ * every bound against both buffers.
+ */
+
+#pragma once
+
+// module includes
+#include "memory/buffer_ref.hpp"
+#include "util/util.hpp"
+
+
+namespace assets::io::lz4
+{
+    /** Largest compressed size of `size` bytes */
+    [[nodiscard]] auto compress_bound(usize size) noexcept -> usize;
+
+    /** Compresses `src` into `dst`, returns the compressed size or zero if `dst` is too small */
+    auto compress(memory::BufferRef src, memory::BufferRef dst) noexcept -> usize;
+
+    /** Decompresses `src` into `dst`, returns the decompressed size or a negative value if malformed */
+    auto decompress(memory::BufferRef src, memory::BufferRef dst) noexcept -> isize;
+}  // namespace assets::io::lz4
@@ -0,0 +1,310 @@
+/** @file mapped_file.cpp */
+
+// module includes
+#include "mapped_file.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+// platform includes
+// clang-format off
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+// clang-format on
+
+// logging
+#include "spdlog/spdlog.h"
+
+
+namespace assets::io::file
+{
+    // ============================================================================================== //
+    // Lines implementation ========================================================================= //
+    // ============================================================================================== //
+
+    Lines::iterator::iterator(std::string_view text) noexcept: m_rest { text }, m_done { false }
+    {
+        this->advance();
+    }
+
+    auto inline Lines::iterator::advance() noexcept -> void
+    {
+        if (m_rest.empty()) {
+            m_done = true;
+            m_line = {};
+            return;
+        }
+
+        auto const *end = static_cast<char const *>(std::memchr(m_rest.data(), '\n', m_rest.size()));
+        auto length     = (end != nullptr) ? static_cast<usize>(end - m_rest.data()) : m_rest.size();
+
+        m_line = m_rest.substr(0U, length);
+        m_rest.remove_prefix(std::min(length + 1U, m_rest.size()));
+
+        if (!m_line.empty() && (m_line.back() == '\r')) {
+            m_line.remove_suffix(1U);
+        }
+    }
+
+    auto Lines::iterator::operator==(iterator const &other) const noexcept -> bool
+    {
+        if (m_done || other.m_done) {
+            return (m_done == other.m_done);
+        }
+
+        return ((m_rest.data() == other.m_rest.data()) && (m_line.data() == other.m_line.data()));
+    }
+
+    auto Lines::iterator::operator!=(iterator const &other) const noexcept -> bool
+    {
+        return (!(*this == other));
+    }
+
+    auto Lines::iterator::operator++() noexcept -> iterator &
+    {
+        this->advance();
+        return (*this);
+    }
+
+    auto Lines::iterator::operator++(int) noexcept -> iterator
+    {
+        auto previous = *this;
+        this->advance();
+
+        return (previous);
+    }
+
+    auto Lines::iterator::operator*() const noexcept -> reference
+    {
+        return (m_line);
+    }
+
+    auto Lines::iterator::operator->() const noexcept -> pointer
+    {
+        return (&m_line);
+    }
+
+    Lines::Lines(std::string_view text) noexcept: m_text { text }
+    {
+    }
+
+    auto Lines::begin() const noexcept -> iterator
+    {
+        return (iterator { m_text });
+    }
+
+    auto Lines::end() const noexcept -> iterator
+    {
+        return (iterator {});
+    }
+
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    MappedFile::MappedFile(std::string_view path, MapHint hint): m_path { path }
+    {
+        SCOPE_FAIL
+        {
+            spdlog::error(fmt::format("IO/ERROR: \'{}\' could not be mapped", m_path));
+        };
+
+#if defined(_WIN32)
+        m_file = CreateFileA(m_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE) {
+            m_file = nullptr;
+            throw std::runtime_error("Cannot open file");
+        }
+
+        LARGE_INTEGER size {};
+        if (!GetFileSizeEx(m_file, &size)) {
+            this->unmap();
+            throw std::runtime_error("Cannot stat file");
+        }
+
+        m_length = static_cast<usize>(size.QuadPart);
+        if (m_length == 0U) {
+            return;
+        }
+
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0U, 0U, nullptr);
+        m_data    = (m_mapping != nullptr) ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0U, 0U, 0U) : nullptr;
+        if (m_data == nullptr) {
+            this->unmap();
+            throw std::runtime_error("Cannot map file");
+        }
+#else
+        auto fd = ::open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open file");
+        }
+
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat file");
+        }
+
+        // empty files cannot be mapped, they are viewed as empty instead
+        m_length = static_cast<usize>(info.st_size);
+        if (m_length == 0U) {
+            ::close(fd);
+            return;
+        }
+
+        auto *data = ::mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (data == MAP_FAILED) {
+            m_length = 0U;
+            throw std::runtime_error("Cannot map file");
+        }
+
+        m_data = data;
+#endif
+
+        this->advise(hint);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        this->unmap();
+    }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept
+      : m_path { std::move(other.m_path) },
+        m_data { std::exchange(other.m_data, nullptr) },
+        m_length { std::exchange(other.m_length, 0U) }
+#if defined(_WIN32)
+        ,
+        m_file { std::exchange(other.m_file, nullptr) },
+        m_mapping { std::exchange(other.m_mapping, nullptr) }
+#endif
+    {
+    }
+
+    auto MappedFile::operator=(MappedFile &&other) noexcept -> MappedFile &
+    {
+        if (this != &other) {
+            this->unmap();
+
+            m_path   = std::move(other.m_path);
+            m_data   = std::exchange(other.m_data, nullptr);
+            m_length = std::exchange(other.m_length, 0U);
+#if defined(_WIN32)
+            m_file    = std::exchange(other.m_file, nullptr);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+        }
+
+        return (*this);
+    }
+
+    // ============================================================================================== //
+    // Utility methods ============================================================================== //
+    // ============================================================================================== //
+
+    auto MappedFile::unmap() noexcept -> void
+    {
+#if defined(_WIN32)
+        if (m_data != nullptr) {
+            UnmapViewOfFile(m_data);
+        }
+
+        if (m_mapping != nullptr) {
+            CloseHandle(m_mapping);
+        }
+
+        if (m_file != nullptr) {
+            CloseHandle(m_file);
+        }
+
+        m_file    = nullptr;
+        m_mapping = nullptr;
+#else
+        if (m_data != nullptr) {
+            ::munmap(m_data, m_length);
+        }
+#endif
+
+        m_data   = nullptr;
+        m_length = 0U;
+    }
+
+    auto MappedFile::advise(MapHint hint) const noexcept -> void
+    {
+#if defined(_WIN32)
+        // windows only offers prefetching, on 8 and later
+        if ((hint == MapHint::WillNeed) && (m_data != nullptr)) {
+            WIN32_MEMORY_RANGE_ENTRY range { m_data, m_length };
+            PrefetchVirtualMemory(GetCurrentProcess(), 1U, &range, 0U);
+        }
+#else
+        if (m_data == nullptr) {
+            return;
+        }
+
+        auto advice = MADV_NORMAL;
+        switch (hint) {
+        case MapHint::Normal: {
+            advice = MADV_NORMAL;
+        } break;
+        case MapHint::Sequential: {
+            advice = MADV_SEQUENTIAL;
+        } break;
+        case MapHint::Random: {
+            advice = MADV_RANDOM;
+        } break;
+        case MapHint::WillNeed: {
+            advice = MADV_WILLNEED;
+        } break;
+        }
+
+        ::madvise(m_data, m_length, advice);
+#endif
+    }
+
+    auto MappedFile::path() const -> std::string const &
+    {
+        return (m_path);
+    }
+
+    auto MappedFile::view() const noexcept -> memory::BufferRef
+    {
+        return (memory::BufferRef { m_data, m_length });
+    }
+
+    auto MappedFile::text() const noexcept -> std::string_view
+    {
+        return (std::string_view { static_cast<char const *>(m_data), m_length });
+    }
+
+    auto MappedFile::lines() const noexcept -> Lines
+    {
+        return (Lines { this->text() });
+    }
+
+    auto MappedFile::length() const noexcept -> usize
+    {
+        return (m_length);
+    }
+
+    auto MappedFile::empty() const noexcept -> bool
+    {
+        return (m_length == 0U);
+    }
+}  // namespace assets::io::file
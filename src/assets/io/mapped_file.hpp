@@ -0,0 +1,118 @@
+/** @file mapped_file.hpp */
+
+#pragma once
+
+// module includes
+#include "memory/buffer_ref.hpp"
+#include "util/util.hpp"
+
+// c++ includes
+#include <iterator>
+#include <string>
+#include <string_view>
+
+
+namespace assets::io::file
+{
+    /** Expected access pattern of a mapping */
+    enum class MapHint
+    {
+        Normal,
+        Sequential,
+        Random,
+        WillNeed,
+    };
+
+    /**
+     * Lines of a text, as views into it
+     *
+     * Lines end at `\n`, a trailing `\r` is dropped. A final newline does not
+     * yield an empty line.
+     */
+    class Lines
+    {
+    private:
+        std::string_view m_text {};
+
+    public:
+        class iterator
+        {
+        private:
+            std::string_view m_rest {};
+            std::string_view m_line {};
+            bool m_done { true };
+
+            auto inline advance() noexcept -> void;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = std::string_view;
+            using difference_type   = isize;
+            using pointer           = std::string_view const *;
+            using reference         = std::string_view const &;
+
+            iterator() = default;
+            explicit iterator(std::string_view text) noexcept;
+
+            auto operator==(iterator const &other) const noexcept -> bool;
+            auto operator!=(iterator const &other) const noexcept -> bool;
+
+            auto operator++() noexcept -> iterator &;
+            auto operator++(int) noexcept -> iterator;
+            auto operator*() const noexcept -> reference;
+            auto operator->() const noexcept -> pointer;
+        };
+
+        explicit Lines(std::string_view text) noexcept;
+
+        [[nodiscard]] auto begin() const noexcept -> iterator;
+        [[nodiscard]] auto end() const noexcept -> iterator;
+    };
+
+    /**
+     * Read-only memory mapping of a whole file
+     *
+     * The contents are viewed in place, neither reading nor splitting them
+     * into lines copies or allocates. Views are invalidated with the mapping.
+     */
+    class MappedFile
+    {
+    private:
+        std::string m_path {};
+
+        void *m_data { nullptr };
+        usize m_length { 0U };
+
+#if defined(_WIN32)
+        void *m_file { nullptr };
+        void *m_mapping { nullptr };
+#endif
+
+        auto unmap() noexcept -> void;
+
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(MappedFile const &) = delete;
+        MappedFile(MappedFile &&other) noexcept;
+
+        auto operator=(MappedFile const &) -> MappedFile & = delete;
+        auto operator=(MappedFile &&other) noexcept -> MappedFile &;
+
+        /** Maps `path`, throws if it cannot be opened or mapped */
+        explicit MappedFile(std::string_view path, MapHint hint = MapHint::Sequential);
+
+        [[nodiscard]] auto path() const -> std::string const &;
+
+        [[nodiscard]] auto view() const noexcept -> memory::BufferRef;
+        [[nodiscard]] auto text() const noexcept -> std::string_view;
+        [[nodiscard]] auto lines() const noexcept -> Lines;
+
+        [[nodiscard]] auto length() const noexcept -> usize;
+        [[nodiscard]] auto empty() const noexcept -> bool;
+
+        /** Hints the kernel about upcoming accesses, a no-op where unsupported */
+        auto advise(MapHint hint) const noexcept -> void;
+    };
+}  // namespace assets::io::file
@@ -0,0 +1,171 @@
+/** @file serializer.cpp */
+
+// module includes
+#include "serializer.hpp"
+
+// c++ includes
+#include <stdexcept>
+#include <utility>
+
+// logging
+#include "spdlog/spdlog.h"
+
+
+namespace assets::io
+{
+    namespace
+    {
+        auto inline pad_to(usize offset, usize alignment) noexcept -> usize
+        {
+            return (((offset + alignment - 1U) / alignment) * alignment);
+        }
+    }  // namespace
+
+    auto malformed_data(std::string_view reason) -> void
+    {
+        spdlog::error(fmt::format("IO/ERROR: Malformed serialized data, {}", reason));
+        throw std::runtime_error("Malformed serialized data");
+    }
+
+    // ============================================================================================== //
+    // BinaryWriter implementation ================================================================== //
+    // ============================================================================================== //
+
+    auto BinaryWriter::bytes(void const *data, usize length) -> void
+    {
+        if (length == 0U) {
+            return;
+        }
+
+        auto const *begin = static_cast<std::uint8_t const *>(data);
+        m_data.insert(m_data.end(), begin, begin + length);
+    }
+
+    auto BinaryWriter::varint(std::uint64_t value) -> void
+    {
+        while (value >= 0x80U) {
+            m_data.push_back(static_cast<std::uint8_t>(value | 0x80U));
+            value >>= 7U;
+        }
+
+        m_data.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    auto BinaryWriter::zigzag(std::int64_t value) -> void
+    {
+        this->varint((static_cast<std::uint64_t>(value) << 1U) ^ static_cast<std::uint64_t>(value >> 63));
+    }
+
+    auto BinaryWriter::align(usize alignment) -> void
+    {
+        m_data.resize(pad_to(m_data.size(), alignment), 0U);
+    }
+
+    auto BinaryWriter::view() const noexcept -> memory::BufferRef
+    {
+        return (memory::BufferRef { m_data.data(), m_data.size() });
+    }
+
+    auto BinaryWriter::size() const noexcept -> usize
+    {
+        return (m_data.size());
+    }
+
+    auto BinaryWriter::take() noexcept -> std::vector<std::uint8_t>
+    {
+        return (std::exchange(m_data, {}));
+    }
+
+    // ============================================================================================== //
+    // BinaryReader implementation ================================================================== //
+    // ============================================================================================== //
+
+    BinaryReader::BinaryReader(memory::BufferRef data) noexcept: m_data { data }
+    {
+    }
+
+    auto BinaryReader::bytes(usize length) -> memory::BufferRef
+    {
+        if (length > this->remaining()) {
+            malformed_data("truncated");
+        }
+
+        auto result = m_data.subview(m_offset, length);
+        m_offset += length;
+
+        return (result);
+    }
+
+    auto BinaryReader::varint() -> std::uint64_t
+    {
+        auto const *data = static_cast<std::uint8_t const *>(m_data.data());
+        auto result      = std::uint64_t { 0U };
+
+        for (auto shift = 0U; shift < 64U; shift += 7U) {
+            if (m_offset >= m_data.length()) {
+                malformed_data("truncated varint");
+            }
+
+            auto byte = data[m_offset++];
+            result |= static_cast<std::uint64_t>(byte & 0x7FU) << shift;
+
+            if ((byte & 0x80U) == 0U) {
+                return (result);
+            }
+        }
+
+        malformed_data("varint too long");
+    }
+
+    auto BinaryReader::zigzag() -> std::int64_t
+    {
+        auto value = this->varint();
+        return (static_cast<std::int64_t>(value >> 1U) ^ -static_cast<std::int64_t>(value & 1U));
+    }
+
+    auto BinaryReader::align(usize alignment) -> void
+    {
+        auto aligned = pad_to(m_offset, alignment);
+        if (aligned > m_data.length()) {
+            malformed_data("truncated padding");
+        }
+
+        m_offset = aligned;
+    }
+
+    auto BinaryReader::offset() const noexcept -> usize
+    {
+        return (m_offset);
+    }
+
+    auto BinaryReader::remaining() const noexcept -> usize
+    {
+        return (m_data.length() - m_offset);
+    }
+
+    // ============================================================================================== //
+    // Codecs ======================================================================================= //
+    // ============================================================================================== //
+
+    auto Codec<event::Event>::write(BinaryWriter &writer, event::Event const &event) -> void
+    {
+        writer.value(event.get_type());
+        writer.value(event.get_category());
+        writer.value(std::string_view { event.get_name() });
+    }
+
+    auto Codec<event::Event>::read(BinaryReader &reader, event::Event &event) -> void
+    {
+        event::EventType type {};
+        event::EventCategory category {};
+        std::string name {};
+
+        reader.value(type);
+        reader.value(category);
+        reader.value(name);
+
+        event.set_type(type);
+        event.set_category(category);
+        event.set_name(name);
+    }
+}  // namespace assets::io
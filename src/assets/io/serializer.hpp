@@ -0,0 +1,388 @@
+/** @file serializer.hpp */
+
+#pragma once
+
+// module includes
+#include "event/event.hpp"
+#include "memory/buffer_ref.hpp"
+#include "util/util.hpp"
+
+// c++ includes
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+
+namespace assets::io
+{
+    static_assert(std::endian::native == std::endian::little, "serialized data is stored little endian");
+
+    class BinaryWriter;
+    class BinaryReader;
+
+    /** How a field is laid out */
+    enum class Encoding
+    {
+        Default,
+        /** Integer sequences as the differences between consecutive elements */
+        Delta,
+    };
+
+    /** Member of a serialized class, present in data of version `Since` onwards */
+    template <class Class, class Member, u32 Since, Encoding Enc>
+    struct Field
+    {
+        char const *name;
+        Member Class::*member;
+    };
+
+    template <u32 Since = 1U, Encoding Enc = Encoding::Default, class Class, class Member>
+    auto constexpr field(char const *name, Member Class::*member) noexcept -> Field<Class, Member, Since, Enc>
+    {
+        return (Field<Class, Member, Since, Enc> { name, member });
+    }
+
+    /**
+     * Field list of a serialized class, to be specialized
+     *
+     * Specializations provide a `version` and a tuple of `fields`. Fields
+     * are stored in order, so new ones go last with the version they were
+     * added in; data of older versions leaves them untouched when read.
+     *
+     * @code
+     * template <>
+     * struct Schema<Player>
+     * {
+     *     u32 static constexpr const version = { 2U };
+     *     auto static constexpr const fields = std::make_tuple(field("position", &Player::position),
+     *                                                          field<2U>("name", &Player::name));
+     * };
+     * @endcode
+     */
+    template <class T>
+    struct Schema;
+
+    /** Hand-written encoding of a type, to be specialized with `write()` and `read()` */
+    template <class T>
+    struct Codec;
+
+    template <class T>
+    concept HasSchema = requires {
+        { Schema<T>::version } -> std::convertible_to<u32>;
+        Schema<T>::fields;
+    };
+
+    template <class T>
+    concept HasCodec = requires(BinaryWriter &writer, BinaryReader &reader, T const &in, T &out) {
+        Codec<T>::write(writer, in);
+        Codec<T>::read(reader, out);
+    };
+
+    namespace details
+    {
+        template <class T>
+        struct is_vec: public std::false_type
+        {
+        };
+
+        template <class T, usize Count>
+        struct is_vec<util::math::Vec<T, Count>>: public std::true_type
+        {
+        };
+
+        template <class T>
+        struct is_const_span: public std::false_type
+        {
+        };
+
+        template <class T>
+        struct is_const_span<std::span<T const>>: public std::true_type
+        {
+        };
+    }  // namespace details
+
+    /** Types stored as their bytes, arrays of them with a single copy */
+    template <class T>
+    concept RawEncoded = std::is_trivially_copyable_v<T>
+                         && (std::is_floating_point_v<T> || details::is_vec<T>::value);
+
+    [[noreturn]] auto malformed_data(std::string_view reason) -> void;
+
+    /** Appends encoded values to a growing buffer */
+    class BinaryWriter
+    {
+    private:
+        std::vector<std::uint8_t> m_data {};
+
+        template <class Class, class Member, u32 Since, Encoding Enc>
+        auto member(Member const &value, Field<Class, Member, Since, Enc> const &field) -> void;
+
+    public:
+        BinaryWriter() = default;
+
+        auto bytes(void const *data, usize length) -> void;
+        auto varint(std::uint64_t value) -> void;
+        auto zigzag(std::int64_t value) -> void;
+
+        /** Pads with zeroes up to a multiple of `alignment` */
+        auto align(usize alignment) -> void;
+
+        template <class T>
+        auto value(T const &value) -> void;
+
+        template <class T, Encoding Enc = Encoding::Default>
+        auto sequence(std::span<T const> values) -> void;
+
+        [[nodiscard]] auto view() const noexcept -> memory::BufferRef;
+        [[nodiscard]] auto size() const noexcept -> usize;
+
+        [[nodiscard]] auto take() noexcept -> std::vector<std::uint8_t>;
+    };
+
+    /**
+     * Decodes values in place from a buffer, e.g. a mapped file
+     *
+     * Strings and raw arrays can be read as views into the buffer, which
+     * they are invalidated with. Arrays are aligned by the writer, so their
+     * views are aligned whenever the buffer start is. Truncated or
+     * malformed data throws.
+     */
+    class BinaryReader
+    {
+    private:
+        memory::BufferRef m_data {};
+        usize m_offset { 0U };
+
+        /** Reads a field if data of `version` has it */
+        template <class Class, class Member, u32 Since, Encoding Enc>
+        auto member(Member &value, Field<Class, Member, Since, Enc> const &field, std::uint64_t version) -> void;
+
+    public:
+        BinaryReader() = default;
+        explicit BinaryReader(memory::BufferRef data) noexcept;
+
+        /** Views the next `length` bytes */
+        auto bytes(usize length) -> memory::BufferRef;
+        auto varint() -> std::uint64_t;
+        auto zigzag() -> std::int64_t;
+
+        /** Skips up to a multiple of `alignment` */
+        auto align(usize alignment) -> void;
+
+        template <class T>
+        auto value(T &value) -> void;
+
+        template <class T, Encoding Enc = Encoding::Default>
+        auto sequence(std::vector<T> &values) -> void;
+
+        /** Views a raw array in place, it has to be aligned */
+        template <RawEncoded T>
+        auto view(std::span<T const> &values) -> void;
+
+        [[nodiscard]] auto offset() const noexcept -> usize;
+        [[nodiscard]] auto remaining() const noexcept -> usize;
+    };
+
+    /** Stored as its type, category and name */
+    template <>
+    struct Codec<event::Event>
+    {
+        auto static write(BinaryWriter &writer, event::Event const &event) -> void;
+        auto static read(BinaryReader &reader, event::Event &event) -> void;
+    };
+
+    // ============================================================================================== //
+    // Writing ====================================================================================== //
+    // ============================================================================================== //
+
+    template <class T>
+    auto BinaryWriter::value(T const &value) -> void
+    {
+        if constexpr (HasCodec<T>) {
+            Codec<T>::write(*this, value);
+        } else if constexpr (HasSchema<T>) {
+            this->varint(Schema<T>::version);
+
+            std::apply(
+                [&](auto const &...fields) -> void {
+                    (this->member(value.*(fields.member), fields), ...);
+                },
+                Schema<T>::fields);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            this->varint(value ? 1U : 0U);
+        } else if constexpr (std::is_enum_v<T>) {
+            this->value(static_cast<std::underlying_type_t<T>>(value));
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            this->zigzag(static_cast<std::int64_t>(value));
+        } else if constexpr (std::is_integral_v<T>) {
+            this->varint(static_cast<std::uint64_t>(value));
+        } else if constexpr (RawEncoded<T>) {
+            this->bytes(&value, sizeof(T));
+        } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+            this->varint(value.size());
+            this->bytes(value.data(), value.size());
+        } else if constexpr (util::traits::is_vector<T>::value || details::is_const_span<T>::value) {
+            this->sequence(std::span<typename T::value_type const> { value });
+        } else {
+            static_assert(!sizeof(T), "type has neither a schema nor a codec");
+        }
+    }
+
+    template <class Class, class Member, u32 Since, Encoding Enc>
+    auto BinaryWriter::member(Member const &value, Field<Class, Member, Since, Enc> const & /*field*/) -> void
+    {
+        if constexpr (Enc == Encoding::Delta) {
+            this->sequence<typename Member::value_type, Enc>(std::span<typename Member::value_type const> { value });
+        } else {
+            this->value(value);
+        }
+    }
+
+    template <class T, Encoding Enc>
+    auto BinaryWriter::sequence(std::span<T const> values) -> void
+    {
+        this->varint(values.size());
+
+        if constexpr (Enc == Encoding::Delta) {
+            static_assert(std::is_integral_v<T>, "only integers can be delta encoded");
+
+            // wrapping differences, so that neither large unsigned values nor steep steps overflow
+            auto previous = std::uint64_t { 0U };
+            for (auto const &element : values) {
+                auto current = static_cast<std::uint64_t>(element);
+                this->zigzag(static_cast<std::int64_t>(current - previous));
+                previous = current;
+            }
+        } else if constexpr (RawEncoded<T>) {
+            this->align(alignof(T));
+            this->bytes(values.data(), values.size_bytes());
+        } else {
+            for (auto const &element : values) {
+                this->value(element);
+            }
+        }
+    }
+
+    // ============================================================================================== //
+    // Reading ====================================================================================== //
+    // ============================================================================================== //
+
+    template <class T>
+    auto BinaryReader::value(T &value) -> void
+    {
+        if constexpr (HasCodec<T>) {
+            Codec<T>::read(*this, value);
+        } else if constexpr (HasSchema<T>) {
+            auto version = this->varint();
+            if (version > Schema<T>::version) {
+                malformed_data("version newer than this build");
+            }
+
+            std::apply(
+                [&](auto const &...fields) -> void {
+                    (this->member(value.*(fields.member), fields, version), ...);
+                },
+                Schema<T>::fields);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            value = (this->varint() != 0U);
+        } else if constexpr (std::is_enum_v<T>) {
+            std::underlying_type_t<T> underlying {};
+            this->value(underlying);
+            value = static_cast<T>(underlying);
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            value = static_cast<T>(this->zigzag());
+        } else if constexpr (std::is_integral_v<T>) {
+            value = static_cast<T>(this->varint());
+        } else if constexpr (RawEncoded<T>) {
+            std::memcpy(&value, this->bytes(sizeof(T)).data(), sizeof(T));
+        } else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+            auto length = this->varint();
+            if (length > this->remaining()) {
+                malformed_data("string out of bounds");
+            }
+
+            auto data = this->bytes(static_cast<usize>(length));
+            value     = T { static_cast<char const *>(data.data()), data.length() };
+        } else if constexpr (util::traits::is_vector<T>::value) {
+            this->sequence(value);
+        } else if constexpr (details::is_const_span<T>::value) {
+            this->view(value);
+        } else {
+            static_assert(!sizeof(T), "type has neither a schema nor a codec");
+        }
+    }
+
+    template <class Class, class Member, u32 Since, Encoding Enc>
+    auto BinaryReader::member(Member &value, Field<Class, Member, Since, Enc> const & /*field*/,
+                              std::uint64_t version) -> void
+    {
+        if (version < Since) {
+            return;
+        }
+
+        if constexpr (Enc == Encoding::Delta) {
+            this->sequence<typename Member::value_type, Enc>(value);
+        } else {
+            this->value(value);
+        }
+    }
+
+    template <class T, Encoding Enc>
+    auto BinaryReader::sequence(std::vector<T> &values) -> void
+    {
+        auto count = this->varint();
+
+        // every element takes a byte at least, which bounds hostile counts
+        if (count > this->remaining()) {
+            malformed_data("sequence out of bounds");
+        }
+
+        values.resize(static_cast<usize>(count));
+
+        if constexpr (Enc == Encoding::Delta) {
+            static_assert(std::is_integral_v<T>, "only integers can be delta encoded");
+
+            auto previous = std::uint64_t { 0U };
+            for (auto &element : values) {
+                previous += static_cast<std::uint64_t>(this->zigzag());
+                element = static_cast<T>(previous);
+            }
+        } else if constexpr (RawEncoded<T>) {
+            this->align(alignof(T));
+
+            auto data = this->bytes(values.size() * sizeof(T));
+            if (!values.empty()) {
+                std::memcpy(values.data(), data.data(), data.length());
+            }
+        } else {
+            for (auto &element : values) {
+                this->value(element);
+            }
+        }
+    }
+
+    template <RawEncoded T>
+    auto BinaryReader::view(std::span<T const> &values) -> void
+    {
+        auto count = this->varint();
+        this->align(alignof(T));
+
+        if (count > (this->remaining() / sizeof(T))) {
+            malformed_data("array out of bounds");
+        }
+
+        auto data = this->bytes(static_cast<usize>(count) * sizeof(T));
+        if ((reinterpret_cast<std::uintptr_t>(data.data()) % alignof(T)) != 0U) {
+            malformed_data("misaligned array");
+        }
+
+        values = std::span<T const> { static_cast<T const *>(data.data()), static_cast<usize>(count) };
+    }
+}  // namespace assets::io
@@ -0,0 +1,353 @@
+/** @file text_parser.cpp */
+
+// module includes
+#include "text_parser.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+// platform includes
+// clang-format off
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+// clang-format on
+
+
+namespace assets::io::file
+{
+    // ============================================================================================== //
+    // Scanning ===================================================================================== //
+    // ============================================================================================== //
+
+    namespace scan
+    {
+        auto find(std::string_view text, char byte) noexcept -> usize
+        {
+            // libc implements it with the widest vectors the CPU has, whatever the build targets
+            auto const *hit = static_cast<char const *>(std::memchr(text.data(), byte, text.size()));
+            return ((hit != nullptr) ? static_cast<usize>(hit - text.data()) : text.size());
+        }
+
+        auto find_any(std::string_view text, ByteSet set) noexcept -> usize
+        {
+            auto const *data = text.data();
+            auto offset      = usize { 0U };
+
+#if defined(__AVX2__)
+            {
+                auto const a = _mm256_set1_epi8(set[0]);
+                auto const b = _mm256_set1_epi8(set[1]);
+                auto const c = _mm256_set1_epi8(set[2]);
+                auto const d = _mm256_set1_epi8(set[3]);
+
+                for (; (offset + 32U) <= text.size(); offset += 32U) {
+                    auto block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + offset));
+                    auto hits  = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, a), _mm256_cmpeq_epi8(block, b)),
+                                                 _mm256_or_si256(_mm256_cmpeq_epi8(block, c), _mm256_cmpeq_epi8(block, d)));
+
+                    auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+                    if (mask != 0U) {
+                        return (offset + static_cast<usize>(std::countr_zero(mask)));
+                    }
+                }
+            }
+#endif
+
+#if defined(__SSE2__)
+            {
+                auto const a = _mm_set1_epi8(set[0]);
+                auto const b = _mm_set1_epi8(set[1]);
+                auto const c = _mm_set1_epi8(set[2]);
+                auto const d = _mm_set1_epi8(set[3]);
+
+                for (; (offset + 16U) <= text.size(); offset += 16U) {
+                    auto block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + offset));
+                    auto hits  = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, a), _mm_cmpeq_epi8(block, b)),
+                                              _mm_or_si128(_mm_cmpeq_epi8(block, c), _mm_cmpeq_epi8(block, d)));
+
+                    auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+                    if (mask != 0U) {
+                        return (offset + static_cast<usize>(std::countr_zero(mask)));
+                    }
+                }
+            }
+#endif
+
+            for (; offset < text.size(); ++offset) {
+                auto byte = data[offset];
+                if ((byte == set[0]) || (byte == set[1]) || (byte == set[2]) || (byte == set[3])) {
+                    return (offset);
+                }
+            }
+
+            return (text.size());
+        }
+
+        auto count(std::string_view text, char byte) noexcept -> usize
+        {
+            auto const *data = text.data();
+            auto offset      = usize { 0U };
+            auto result      = usize { 0U };
+
+#if defined(__AVX2__)
+            {
+                auto const needle = _mm256_set1_epi8(byte);
+
+                for (; (offset + 32U) <= text.size(); offset += 32U) {
+                    auto block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + offset));
+                    auto mask  = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+
+                    result += static_cast<usize>(std::popcount(mask));
+                }
+            }
+#endif
+
+#if defined(__SSE2__)
+            {
+                auto const needle = _mm_set1_epi8(byte);
+
+                for (; (offset + 16U) <= text.size(); offset += 16U) {
+                    auto block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + offset));
+                    auto mask  = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+
+                    result += static_cast<usize>(std::popcount(mask));
+                }
+            }
+#endif
+
+            for (; offset < text.size(); ++offset) {
+                result += (data[offset] == byte) ? 1U : 0U;
+            }
+
+            return (result);
+        }
+    }  // namespace scan
+
+    namespace
+    {
+        /** Tokens of a single chunk, line numbers and indices relative to it */
+        struct Partial
+        {
+            std::vector<std::string_view> tokens {};
+            std::vector<Record> records {};
+            /** Line ends in the chunk */
+            std::uint32_t newlines { 0U };
+        };
+
+        auto trim(std::string_view field) noexcept -> std::string_view
+        {
+            auto blank = [](char byte) -> bool { return ((byte == ' ') || (byte == '\t') || (byte == '\r')); };
+
+            while (!field.empty() && blank(field.front())) {
+                field.remove_prefix(1U);
+            }
+
+            while (!field.empty() && blank(field.back())) {
+                field.remove_suffix(1U);
+            }
+
+            return (field);
+        }
+
+        auto tokenize(std::string_view text, ParseOptions const &options, Partial &out) -> void
+        {
+            auto spaces  = (options.separator == ' ');
+            auto comment = (options.comment != '\0') ? options.comment : '\n';
+
+            // line ends, field ends and comments in a single scan
+            auto set = spaces ? scan::ByteSet { '\n', ' ', '\t', comment }
+                              : scan::ByteSet { '\n', options.separator, comment, '\n' };
+
+            auto line  = std::uint32_t { 1U };
+            auto first = out.tokens.size();
+
+            auto field = [&](usize begin, usize end) -> void {
+                auto token = trim(text.substr(begin, end - begin));
+
+                // runs of blanks are one separator
+                if (!spaces || !token.empty()) {
+                    out.tokens.push_back(token);
+                }
+            };
+
+            auto end_line = [&]() -> void {
+                auto count = out.tokens.size() - first;
+
+                // a blank line is a single empty field
+                if (!spaces && (count == 1U) && out.tokens.back().empty()) {
+                    out.tokens.pop_back();
+                    count = 0U;
+                }
+
+                if (count > 0U) {
+                    out.records.push_back(
+                        Record { line, static_cast<std::uint32_t>(first), static_cast<std::uint32_t>(count) });
+                }
+
+                first = out.tokens.size();
+                ++line;
+            };
+
+            auto start = usize { 0U };
+
+            while (true) {
+                auto at = start + scan::find_any(text.substr(start), set);
+
+                if (at == text.size()) {
+                    if (start < at || (first != out.tokens.size())) {
+                        field(start, at);
+                        end_line();
+                    }
+                    break;
+                }
+
+                field(start, at);
+
+                if (text[at] == '\n') {
+                    end_line();
+                } else if (text[at] == comment) {
+                    at += scan::find(text.substr(at), '\n');
+                    end_line();
+
+                    if (at == text.size()) {
+                        break;
+                    }
+                }
+
+                start = at + 1U;
+            }
+
+            out.newlines = static_cast<std::uint32_t>(scan::count(text, '\n'));
+        }
+
+        /** Splits `text` into chunks of at least `size` bytes ending at line ends */
+        auto split(std::string_view text, usize size) -> std::vector<std::string_view>
+        {
+            std::vector<std::string_view> chunks {};
+            size = std::max(size, usize { 1U });
+
+            for (auto begin = usize { 0U }; begin < text.size();) {
+                auto end = text.size();
+
+                if ((text.size() - begin) > size) {
+                    end = begin + size;
+                    end = std::min(end + scan::find(text.substr(end), '\n') + 1U, text.size());
+                }
+
+                chunks.push_back(text.substr(begin, end - begin));
+                begin = end;
+            }
+
+            return (chunks);
+        }
+    }  // namespace
+
+    // ============================================================================================== //
+    // ParsedText implementation ==================================================================== //
+    // ============================================================================================== //
+
+    auto ParsedText::records() const noexcept -> std::span<Record const>
+    {
+        return (m_records);
+    }
+
+    auto ParsedText::tokens() const noexcept -> std::span<std::string_view const>
+    {
+        return (m_tokens);
+    }
+
+    auto ParsedText::fields(Record const &record) const noexcept -> std::span<std::string_view const>
+    {
+        return (this->tokens().subspan(record.first, record.count));
+    }
+
+    auto ParsedText::size() const noexcept -> usize
+    {
+        return (m_records.size());
+    }
+
+    auto ParsedText::empty() const noexcept -> bool
+    {
+        return (m_records.empty());
+    }
+
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    TextParser::TextParser() = default;
+
+    TextParser::TextParser(usize threads): m_pool { threads }
+    {
+    }
+
+    TextParser::~TextParser() = default;
+
+    // ============================================================================================== //
+    // TextParser implementation ==================================================================== //
+    // ============================================================================================== //
+
+    auto TextParser::parse(std::string_view text, ParseOptions const &options) -> ParsedText
+    {
+        auto chunks = split(text, options.chunk_size);
+        std::vector<Partial> partials(chunks.size());
+
+        auto job = std::make_shared<ChunkJob>(chunks.size(), [&](usize index) -> void {
+            tokenize(chunks[index], options, partials[index]);
+        });
+
+        m_pool.start(job);
+        job->wait();
+        job->rethrow();
+
+        ParsedText result {};
+
+        auto tokens  = usize { 0U };
+        auto records = usize { 0U };
+        for (auto const &partial : partials) {
+            tokens += partial.tokens.size();
+            records += partial.records.size();
+        }
+
+        result.m_tokens.reserve(tokens);
+        result.m_records.reserve(records);
+
+        auto lines = std::uint32_t { 0U };
+        for (auto &partial : partials) {
+            auto first = static_cast<std::uint32_t>(result.m_tokens.size());
+
+            result.m_tokens.insert(result.m_tokens.end(), partial.tokens.begin(), partial.tokens.end());
+            for (auto record : partial.records) {
+                record.line += lines;
+                record.first += first;
+                result.m_records.push_back(record);
+            }
+
+            lines += partial.newlines;
+        }
+
+        return (result);
+    }
+
+    auto TextParser::parse(memory::BufferRef text, ParseOptions const &options) -> ParsedText
+    {
+        return (this->parse(std::string_view { static_cast<char const *>(text.data()), text.length() }, options));
+    }
+
+    auto TextParser::parse(MappedFile const &file, ParseOptions const &options) -> ParsedText
+    {
+        file.advise(MapHint::WillNeed);
+        return (this->parse(file.text(), options));
+    }
+
+    auto TextParser::workers() const noexcept -> usize
+    {
+        return (m_pool.workers());
+    }
+}  // namespace assets::io::file
@@ -0,0 +1,111 @@
+/** @file text_parser.hpp */
+
+#pragma once
+
+// module includes
+#include "chunk_pool.hpp"
+#include "mapped_file.hpp"
+#include "memory/buffer_ref.hpp"
+#include "util/util.hpp"
+
+// c++ includes
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+
+namespace assets::io::file
+{
+    namespace scan
+    {
+        /** Up to four bytes searched for at once, unused slots repeat one of them */
+        using ByteSet = std::array<char, 4>;
+
+        /** Offset of the first `byte` in `text`, its length when there is none */
+        [[nodiscard]] auto find(std::string_view text, char byte) noexcept -> usize;
+
+        /** Offset of the first byte of `text` in `set`, its length when there is none */
+        [[nodiscard]] auto find_any(std::string_view text, ByteSet set) noexcept -> usize;
+
+        /** Amount of `byte` in `text` */
+        [[nodiscard]] auto count(std::string_view text, char byte) noexcept -> usize;
+    }  // namespace scan
+
+    struct ParseOptions
+    {
+        /** Separates the fields of a record, `' '` meaning runs of spaces and tabs */
+        char separator { ' ' };
+        /** Starts a comment running to the end of the line, `'\0'` for none */
+        char comment { '#' };
+        /** Texts are split into chunks of about this many bytes, at line ends */
+        usize chunk_size { 1024U * 1024U };
+    };
+
+    /** Non-empty line of a text, its fields being consecutive tokens */
+    struct Record
+    {
+        /** Line number, starting at 1 */
+        std::uint32_t line;
+        /** Index of the first field in the tokens */
+        std::uint32_t first;
+        std::uint32_t count;
+    };
+
+    /**
+     * Records of a text, as views into it
+     *
+     * Fields are trimmed of spaces, tabs and `\r`. Blank and comment only
+     * lines are not records. Views are invalidated with the text.
+     */
+    class ParsedText
+    {
+    private:
+        std::vector<std::string_view> m_tokens {};
+        std::vector<Record> m_records {};
+
+        friend class TextParser;
+
+    public:
+        [[nodiscard]] auto records() const noexcept -> std::span<Record const>;
+        [[nodiscard]] auto tokens() const noexcept -> std::span<std::string_view const>;
+
+        /** Fields of `record` */
+        [[nodiscard]] auto fields(Record const &record) const noexcept -> std::span<std::string_view const>;
+
+        [[nodiscard]] auto size() const noexcept -> usize;
+        [[nodiscard]] auto empty() const noexcept -> bool;
+    };
+
+    /**
+     * Tokenizes texts on a pool of workers without copying them
+     *
+     * Line and field boundaries are found 16 or 32 bytes at a time where
+     * the target supports it. Texts larger than a chunk are split at line
+     * ends and the chunks tokenized in parallel, the calling thread taking
+     * part, then stitched back in order.
+     */
+    class TextParser: private NonCopyable
+    {
+    private:
+        ChunkPool m_pool;
+
+    public:
+        /** One worker less than hardware threads, the caller being the last one */
+        TextParser();
+        explicit TextParser(usize threads);
+        ~TextParser();
+
+        TextParser(TextParser &&)                    = delete;
+        auto operator=(TextParser &&) -> TextParser & = delete;
+
+        [[nodiscard]] auto parse(std::string_view text, ParseOptions const &options = {}) -> ParsedText;
+        [[nodiscard]] auto parse(memory::BufferRef text, ParseOptions const &options = {}) -> ParsedText;
+
+        /** Views are invalidated with the mapping */
+        [[nodiscard]] auto parse(MappedFile const &file, ParseOptions const &options = {}) -> ParsedText;
+
+        [[nodiscard]] auto workers() const noexcept -> usize;
+    };
+}  // namespace assets::io::file
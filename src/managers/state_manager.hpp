@@ -20,5 +20,10 @@ namespace managers
         {
             return (m_state.platform.m_window);
         }
+
+        [[nodiscard]] auto get_frame_allocator() -> memory::DefaultFrameAllocator &
+        {
+            return (m_state.frame_allocator);
+        }
     };
 }  // namespace managers
@@ -45,7 +45,7 @@ namespace memory::detail
 namespace memory
 {
     template <class Allocator, class P, class S = void, bool V = false>
-    class AffixAllocator: public AllocatorInterface
+    class AffixAllocator: private NonCopyable
     {
     private:
         using self = AffixAllocator<Allocator, P, S, V>;
@@ -71,8 +71,8 @@ namespace memory
 
         bool static constexpr const verify { V };
 
-        auto alloc(usize size) -> Block override;
-        auto owns(Block &block) const noexcept -> bool override;
-        auto free(Block &block) -> void override;
+        auto alloc(usize size) -> Block;
+        auto owns(Block &block) const noexcept -> bool;
+        auto free(Block &block) -> void;
     };
 }  // namespace memory
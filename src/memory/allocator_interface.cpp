@@ -0,0 +1,17 @@
+/** @file allocator_interface.cpp */
+
+// module includes
+#include "allocator_interface.hpp"
+
+namespace memory
+{
+    auto AllocatorInterface::expand(Block & /*block*/, usize /*delta*/) -> bool
+    {
+        return (false);
+    }
+
+    auto AllocatorInterface::reallocate(Block &block, usize new_size) -> bool
+    {
+        return (memory::reallocate_by_copy(*this, block, new_size));
+    }
+}  // namespace memory
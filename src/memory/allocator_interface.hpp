@@ -3,15 +3,38 @@
 #pragma once
 
 // module includes
+#include "block.hpp"
 #include "util/util.hpp"
 #include "utils.hpp"
 
-namespace memory
+// c++ includes
+#include <concepts>
+#include <cstring>
+
+namespace memory::detail
 {
-    // forward reference
-    class Block;
+    /** Allocators able to grow a block in place */
+    template <class A>
+    concept CanExpand = requires(A &allocator, Block &block, usize delta) {
+        { allocator.expand(block, delta) } -> std::same_as<bool>;
+    };
 
-    /** Describes an abstract allocator interface */
+    /** Allocators with their own resizing strategy */
+    template <class A>
+    concept CanReallocate = requires(A &allocator, Block &block, usize new_size) {
+        { allocator.reallocate(block, new_size) } -> std::same_as<bool>;
+    };
+}  // namespace memory::detail
+
+namespace memory
+{
+    /**
+     * Describes an abstract allocator interface
+     *
+     * Allocators satisfy `IsAllocator` structurally and are composed as
+     * template parameters without virtual calls. This interface is only for
+     * places that need runtime polymorphism, see `PolymorphicAllocator`.
+     */
     class AllocatorInterface: private NonCopyable
     {
     public:
@@ -25,5 +48,105 @@ namespace memory
 
         /** Deallocate the selected block */
         auto virtual free(Block &block) -> void = 0;
+
+        /**
+         * Grows a block in place
+         *
+         * @param block block to grow, its size is updated on success
+         * @param delta amount of bytes to append
+         * @return whether the block was grown, it is left untouched otherwise
+         */
+        auto virtual expand(Block &block, usize delta) -> bool;
+
+        /**
+         * Resizes a block, in place when possible
+         *
+         * @param block block to resize, updated on success
+         * @param new_size requested size
+         * @return whether the block was resized, it is left untouched otherwise
+         */
+        auto virtual reallocate(Block &block, usize new_size) -> bool;
     };
+
+    /**
+     * Grows a block in place if the allocator supports it
+     *
+     * @param allocator allocator owning `block`
+     * @param block block to grow, its size is updated on success
+     * @param delta amount of bytes to append
+     * @return whether the block was grown
+     */
+    template <IsAllocator A>
+    auto inline expand(A &allocator, Block &block, usize delta) -> bool
+    {
+        if constexpr (detail::CanExpand<A>) {
+            return (allocator.expand(block, delta));
+        } else {
+            return (false);
+        }
+    }
+
+    /**
+     * Resizes a block without allocator specific shortcuts
+     *
+     * Growing first tries `expand()`, then falls back to alloc, copy and free.
+     * Shrinking keeps the block as is. A size of zero frees the block.
+     *
+     * @param allocator allocator owning `block`
+     * @param block block to resize, updated on success
+     * @param new_size requested size
+     * @return whether the block was resized, it is left untouched otherwise
+     */
+    template <IsAllocator A>
+    auto inline reallocate_by_copy(A &allocator, Block &block, usize new_size) -> bool
+    {
+        if (block == null_block) {
+            block = allocator.alloc(new_size);
+            return ((new_size == 0U) || (block != null_block));
+        }
+
+        if (new_size == 0U) {
+            allocator.free(block);
+            block = null_block;
+
+            return (true);
+        }
+
+        if (new_size <= block.size) {
+            return (true);
+        }
+
+        if (memory::expand(allocator, block, new_size - block.size)) {
+            return (true);
+        }
+
+        auto result = allocator.alloc(new_size);
+        if (result == null_block) {
+            return (false);
+        }
+
+        std::memcpy(result.addr, block.addr, block.size);
+        allocator.free(block);
+
+        block = result;
+        return (true);
+    }
+
+    /**
+     * Resizes a block, in place when the allocator can
+     *
+     * @param allocator allocator owning `block`
+     * @param block block to resize, updated on success
+     * @param new_size requested size
+     * @return whether the block was resized, it is left untouched otherwise
+     */
+    template <IsAllocator A>
+    auto inline reallocate(A &allocator, Block &block, usize new_size) -> bool
+    {
+        if constexpr (detail::CanReallocate<A>) {
+            return (allocator.reallocate(block, new_size));
+        } else {
+            return (memory::reallocate_by_copy(allocator, block, new_size));
+        }
+    }
 }  // namespace memory
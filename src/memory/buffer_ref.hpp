@@ -7,8 +7,44 @@
 #include "util/util.hpp"
 #include "utils.hpp"
 
+// c++ includes
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// c includes
+#if !defined(_WIN32)
+#include <sys/uio.h>
+#endif
+
+namespace memory::detail
+{
+    /** Logs `message` and throws a `std::runtime_error` carrying `what` */
+    [[noreturn]] auto buffer_error(std::string const &message, char const *what) -> void;
+}  // namespace memory::detail
+
 namespace memory
 {
+#if defined(_WIN32)
+    /** Mirrors the POSIX scatter-gather element */
+    struct IoVec
+    {
+        void *iov_base;
+        usize iov_len;
+    };
+#else
+    using IoVec = ::iovec;
+#endif
+
+    /**
+     * Non-owning view over a range of bytes
+     *
+     * Subviews and typed views alias the same memory, nothing is ever copied.
+     */
     class BufferRef
     {
     private:
@@ -16,6 +52,11 @@ namespace memory
         usize m_length { 0U };
 
     public:
+        /** Length meaning "up to the end of the buffer" */
+        usize static constexpr const npos { std::numeric_limits<usize>::max() };
+
+        BufferRef() = default;
+
         template <class Ptr>
         explicit inline BufferRef(Ptr *data, usize length);
 
@@ -25,6 +66,9 @@ namespace memory
         template <class Ptr>
         explicit inline BufferRef(Ptr *m_data);
 
+        template <class T>
+        explicit inline BufferRef(std::span<T> span);
+
         explicit inline BufferRef(Block const &block);
 
         explicit inline BufferRef(std::string const &string);
@@ -37,7 +81,147 @@ namespace memory
         requires std::is_pointer_v<Ptr>
         auto inline as_ptr() noexcept -> Ptr;
 
+        /**
+         * Views the buffer as contiguous `T`s
+         *
+         * Throws if the buffer is misaligned for `T` or its length is not a
+         * multiple of `sizeof(T)`.
+         */
+        template <class T>
+        requires std::is_trivially_copyable_v<T>
+        [[nodiscard]] auto inline as_span() const -> std::span<T>;
+
+        [[nodiscard]] auto inline as_bytes() const noexcept -> std::span<std::byte>;
+
+        [[nodiscard]] auto inline data() const noexcept -> void *;
         [[nodiscard]] auto inline length() const noexcept -> usize;
+        [[nodiscard]] auto inline empty() const noexcept -> bool;
+
+        /** First `length` bytes, throws past the end */
         [[nodiscard]] auto inline slice(usize length) const -> BufferRef;
+
+        /** `length` bytes from `offset`, clamped to the end for `npos`, throws past the end */
+        [[nodiscard]] auto inline subview(usize offset, usize length = npos) const -> BufferRef;
+
+        /** Last `length` bytes, throws past the front */
+        [[nodiscard]] auto inline last(usize length) const -> BufferRef;
+    };
+
+    /**
+     * Reference counted buffer, freed back to its allocator with the last reference
+     *
+     * The count and the bytes come from a single allocation. Subviews share
+     * the count, so any of them keeps the whole allocation alive. The
+     * allocator must outlive every reference.
+     */
+    class SharedBuffer
+    {
+    private:
+        struct Control
+        {
+            std::atomic<usize> refs;
+            /** Upstream block holding both the control and the bytes */
+            Block block;
+            void *allocator;
+            auto (*release)(void *allocator, Block &block) -> void;
+            /** Bytes requested, handed to the hook */
+            usize length;
+            auto (*hook)(void *context, usize length) noexcept -> void;
+            void *context;
+        };
+
+        usize static constexpr const header_size { align_size<alignof(std::max_align_t)>(sizeof(Control)) };
+
+        Control *m_control { nullptr };
+        BufferRef m_view {};
+
+        inline SharedBuffer(Control *control, BufferRef view) noexcept;
+
+        auto inline retain() const noexcept -> void;
+        auto inline drop() noexcept -> void;
+
+    public:
+        SharedBuffer() = default;
+        inline ~SharedBuffer();
+
+        inline SharedBuffer(SharedBuffer const &other) noexcept;
+        inline SharedBuffer(SharedBuffer &&other) noexcept;
+
+        auto inline operator=(SharedBuffer const &other) noexcept -> SharedBuffer &;
+        auto inline operator=(SharedBuffer &&other) noexcept -> SharedBuffer &;
+
+        /** Allocates `length` bytes from `allocator`, empty if it is exhausted */
+        template <IsAllocator Allocator>
+        [[nodiscard]] auto static inline allocate(Allocator &allocator, usize length) -> SharedBuffer;
+
+        [[nodiscard]] auto inline view() const noexcept -> BufferRef;
+        [[nodiscard]] auto inline data() const noexcept -> void *;
+        [[nodiscard]] auto inline length() const noexcept -> usize;
+        [[nodiscard]] auto inline empty() const noexcept -> bool;
+
+        /** Subview sharing ownership of the whole allocation */
+        [[nodiscard]] auto inline subview(usize offset, usize length = BufferRef::npos) const -> SharedBuffer;
+
+        /** References to the allocation, zero for an empty buffer */
+        [[nodiscard]] auto inline use_count() const noexcept -> usize;
+
+        /**
+         * Calls `hook` with the allocated length once the allocation is freed
+         *
+         * An allocation takes a single hook, which runs on whichever thread
+         * drops the last reference. Concurrent calls are not safe.
+         *
+         * @return false if the buffer is empty or already has a hook
+         */
+        auto inline on_release(auto (*hook)(void *context, usize length) noexcept -> void, void *context) noexcept
+            -> bool;
+
+        explicit inline operator bool() const noexcept;
+    };
+
+    /**
+     * Ordered buffers laid out as `iovec`s
+     *
+     * `segments()` goes straight to `readv`/`writev` without flattening the
+     * chain, split it yourself past `IOV_MAX`. Borrowed buffers must outlive
+     * the chain, shared ones are kept alive by it.
+     */
+    class BufferChain
+    {
+    private:
+        std::vector<IoVec> m_segments {};
+        std::vector<SharedBuffer> m_owners {};
+
+        /** First segment not consumed yet */
+        usize m_first { 0U };
+        /** Bytes left from `m_first` on */
+        usize m_length { 0U };
+
+    public:
+        /** Appends a borrowed buffer, empty ones are skipped */
+        auto inline append(BufferRef buffer) -> BufferChain &;
+
+        /** Appends a shared buffer, kept alive until the chain is cleared */
+        auto inline append(SharedBuffer buffer) -> BufferChain &;
+
+        /** Drops `bytes` from the front, i.e. after a partial `readv`/`writev` */
+        auto inline consume(usize bytes) -> void;
+
+        auto inline clear() noexcept -> void;
+
+        /** Gathers the chain into `target`, returns the amount of bytes copied */
+        auto inline copy_to(BufferRef target) const noexcept -> usize;
+
+        [[nodiscard]] auto inline segments() const noexcept -> std::span<IoVec const>;
+        [[nodiscard]] auto inline operator[](usize index) const -> BufferRef;
+
+        /** Amount of segments left */
+        [[nodiscard]] auto inline size() const noexcept -> usize;
+        /** Amount of bytes left */
+        [[nodiscard]] auto inline length() const noexcept -> usize;
+        [[nodiscard]] auto inline empty() const noexcept -> bool;
     };
 }  // namespace memory
+
+// inline definitions
+#include "buffer_ref.inl"
@@ -0,0 +1,398 @@
+/** @file buffer_ref.inl
+ * Inline and template definitions of `buffer_ref.hpp`, included by it
+ */
+
+#pragma once
+
+// module includes
+#include "buffer_ref.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace memory
+{
+    // ============================================================================================== //
+    // BufferRef implementation ===================================================================== //
+    // ============================================================================================== //
+
+    template <class Ptr>
+    inline BufferRef::BufferRef(Ptr *data, usize length)
+      : m_data { reinterpret_cast<void *>(data) }, m_length { length }
+    {
+    }
+
+    template <class Ptr>
+    inline BufferRef::BufferRef(Ptr const *data, usize length)
+      : m_data { reinterpret_cast<void *>(const_cast<Ptr *>(data)) }, m_length(length)
+    {
+    }
+
+    template <class Ptr>
+    inline BufferRef::BufferRef(Ptr *data)
+      : m_data { reinterpret_cast<void *>(data) }, m_length { sizeof(Ptr) }
+    {
+    }
+
+    template <class T>
+    inline BufferRef::BufferRef(std::span<T> span)
+      : m_data { const_cast<void *>(static_cast<void const *>(span.data())) }, m_length { span.size_bytes() }
+    {
+    }
+
+    inline BufferRef::BufferRef(Block const &block): m_data { block.addr }, m_length { block.size }
+    {
+    }
+
+    inline BufferRef::BufferRef(std::string const &string)
+      : m_data { reinterpret_cast<void *>(const_cast<char *>(string.data())) }, m_length { string.length() }
+    {
+    }
+
+    template <class Ref>
+    requires std::is_reference_v<Ref>
+    auto inline BufferRef::as_ref() noexcept -> Ref
+    {
+        using base_type    = std::remove_reference_t<Ref>;
+        using pointer_type = std::add_pointer_t<base_type>;
+
+        return (*reinterpret_cast<pointer_type>(m_data));
+    }
+
+    template <class Ptr>
+    requires std::is_pointer_v<Ptr>
+    auto inline BufferRef::as_ptr() noexcept -> Ptr
+    {
+        return (reinterpret_cast<Ptr>(m_data));
+    }
+
+    template <class T>
+    requires std::is_trivially_copyable_v<T>
+    auto inline BufferRef::as_span() const -> std::span<T>
+    {
+        if ((reinterpret_cast<uintptr>(m_data) % alignof(T)) != 0U) {
+            detail::buffer_error(fmt::format("Buffer at {} is misaligned for a {} byte alignment", m_data, alignof(T)),
+                                 "Misaligned typed buffer view");
+        }
+
+        if ((m_length % sizeof(T)) != 0U) {
+            detail::buffer_error(fmt::format("Buffer of {} bytes is not a multiple of {} bytes", m_length, sizeof(T)),
+                                 "Truncated typed buffer view");
+        }
+
+        return (std::span<T> { static_cast<T *>(m_data), m_length / sizeof(T) });
+    }
+
+    auto inline BufferRef::as_bytes() const noexcept -> std::span<std::byte>
+    {
+        return (std::span<std::byte> { static_cast<std::byte *>(m_data), m_length });
+    }
+
+    auto inline BufferRef::data() const noexcept -> void *
+    {
+        return (m_data);
+    }
+
+    auto inline BufferRef::length() const noexcept -> usize
+    {
+        return (m_length);
+    }
+
+    auto inline BufferRef::empty() const noexcept -> bool
+    {
+        return (m_length == 0U);
+    }
+
+    auto inline BufferRef::slice(usize length) const -> BufferRef
+    {
+        return (this->subview(0U, length));
+    }
+
+    auto inline BufferRef::subview(usize offset, usize length) const -> BufferRef
+    {
+        if (offset > m_length) {
+            detail::buffer_error(fmt::format("Offset {} is past the end of a {} bytes buffer", offset, m_length),
+                                 "Buffer subview out of bounds");
+        }
+
+        auto left = m_length - offset;
+        if (length == npos) {
+            length = left;
+        }
+
+        if (length > left) {
+            detail::buffer_error(
+                fmt::format("Subview of {} bytes at {} overruns a {} bytes buffer", length, offset, m_length),
+                "Buffer subview out of bounds");
+        }
+
+        return (BufferRef { static_cast<u8 *>(m_data) + offset, length });
+    }
+
+    auto inline BufferRef::last(usize length) const -> BufferRef
+    {
+        if (length > m_length) {
+            detail::buffer_error(fmt::format("Subview of {} bytes overruns a {} bytes buffer", length, m_length),
+                                 "Buffer subview out of bounds");
+        }
+
+        return (this->subview(m_length - length, length));
+    }
+
+    // ============================================================================================== //
+    // SharedBuffer implementation ================================================================== //
+    // ============================================================================================== //
+
+    inline SharedBuffer::SharedBuffer(Control *control, BufferRef view) noexcept
+      : m_control { control }, m_view { view }
+    {
+    }
+
+    inline SharedBuffer::~SharedBuffer()
+    {
+        this->drop();
+    }
+
+    inline SharedBuffer::SharedBuffer(SharedBuffer const &other) noexcept
+      : m_control { other.m_control }, m_view { other.m_view }
+    {
+        this->retain();
+    }
+
+    inline SharedBuffer::SharedBuffer(SharedBuffer &&other) noexcept
+      : m_control { std::exchange(other.m_control, nullptr) }, m_view { std::exchange(other.m_view, BufferRef {}) }
+    {
+    }
+
+    auto inline SharedBuffer::operator=(SharedBuffer const &other) noexcept -> SharedBuffer &
+    {
+        if (this != &other) {
+            other.retain();
+            this->drop();
+
+            m_control = other.m_control;
+            m_view    = other.m_view;
+        }
+
+        return (*this);
+    }
+
+    auto inline SharedBuffer::operator=(SharedBuffer &&other) noexcept -> SharedBuffer &
+    {
+        if (this != &other) {
+            this->drop();
+
+            m_control = std::exchange(other.m_control, nullptr);
+            m_view    = std::exchange(other.m_view, BufferRef {});
+        }
+
+        return (*this);
+    }
+
+    auto inline SharedBuffer::retain() const noexcept -> void
+    {
+        if (m_control != nullptr) {
+            m_control->refs.fetch_add(1U, std::memory_order_relaxed);
+        }
+    }
+
+    auto inline SharedBuffer::drop() noexcept -> void
+    {
+        if (m_control == nullptr) {
+            return;
+        }
+
+        if (m_control->refs.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+            auto block     = m_control->block;
+            auto allocator = m_control->allocator;
+            auto release   = m_control->release;
+            auto length    = m_control->length;
+            auto hook      = m_control->hook;
+            auto context   = m_control->context;
+
+            m_control->~Control();
+            release(allocator, block);
+
+            if (hook != nullptr) {
+                hook(context, length);
+            }
+        }
+
+        m_control = nullptr;
+        m_view    = BufferRef {};
+    }
+
+    template <IsAllocator Allocator>
+    auto inline SharedBuffer::allocate(Allocator &allocator, usize length) -> SharedBuffer
+    {
+        auto block = allocator.alloc(header_size + length);
+        if (block == null_block) {
+            return (SharedBuffer {});
+        }
+
+        auto release = [](void *allocator, Block &block) -> void { static_cast<Allocator *>(allocator)->free(block); };
+        auto control = new (block.addr) Control { { 1U }, block, &allocator, release, length, nullptr, nullptr };
+
+        return (SharedBuffer { control, BufferRef { static_cast<u8 *>(block) + header_size, length } });
+    }
+
+    auto inline SharedBuffer::view() const noexcept -> BufferRef
+    {
+        return (m_view);
+    }
+
+    auto inline SharedBuffer::data() const noexcept -> void *
+    {
+        return (m_view.data());
+    }
+
+    auto inline SharedBuffer::length() const noexcept -> usize
+    {
+        return (m_view.length());
+    }
+
+    auto inline SharedBuffer::empty() const noexcept -> bool
+    {
+        return (m_view.empty());
+    }
+
+    auto inline SharedBuffer::subview(usize offset, usize length) const -> SharedBuffer
+    {
+        auto view = m_view.subview(offset, length);
+        this->retain();
+
+        return (SharedBuffer { m_control, view });
+    }
+
+    auto inline SharedBuffer::use_count() const noexcept -> usize
+    {
+        return ((m_control != nullptr) ? m_control->refs.load(std::memory_order_relaxed) : 0U);
+    }
+
+    auto inline SharedBuffer::on_release(auto (*hook)(void *context, usize length) noexcept -> void,
+                                         void *context) noexcept -> bool
+    {
+        if ((m_control == nullptr) || (m_control->hook != nullptr)) {
+            return (false);
+        }
+
+        // published to the last reference by the release ordering of `drop()`
+        m_control->hook    = hook;
+        m_control->context = context;
+
+        return (true);
+    }
+
+    inline SharedBuffer::operator bool() const noexcept
+    {
+        return (m_control != nullptr);
+    }
+
+    // ============================================================================================== //
+    // BufferChain implementation =================================================================== //
+    // ============================================================================================== //
+
+    auto inline BufferChain::append(BufferRef buffer) -> BufferChain &
+    {
+        if (!buffer.empty()) {
+            m_segments.push_back(IoVec { buffer.data(), buffer.length() });
+            m_length += buffer.length();
+        }
+
+        return (*this);
+    }
+
+    auto inline BufferChain::append(SharedBuffer buffer) -> BufferChain &
+    {
+        if (!buffer.empty()) {
+            this->append(buffer.view());
+            m_owners.push_back(std::move(buffer));
+        }
+
+        return (*this);
+    }
+
+    auto inline BufferChain::consume(usize bytes) -> void
+    {
+        if (bytes > m_length) {
+            detail::buffer_error(fmt::format("Cannot consume {} bytes out of a {} bytes chain", bytes, m_length),
+                                 "Buffer chain consumed out of bounds");
+        }
+
+        m_length -= bytes;
+
+        while (bytes > 0U) {
+            auto &segment = m_segments[m_first];
+
+            if (bytes < segment.iov_len) {
+                segment.iov_base = static_cast<u8 *>(segment.iov_base) + bytes;
+                segment.iov_len -= bytes;
+                break;
+            }
+
+            bytes -= segment.iov_len;
+            m_first += 1U;
+        }
+
+        if (m_first == m_segments.size()) {
+            this->clear();
+        }
+    }
+
+    auto inline BufferChain::clear() noexcept -> void
+    {
+        m_segments.clear();
+        m_owners.clear();
+        m_first  = 0U;
+        m_length = 0U;
+    }
+
+    auto inline BufferChain::copy_to(BufferRef target) const noexcept -> usize
+    {
+        auto *cursor = static_cast<u8 *>(target.data());
+        auto left    = target.length();
+
+        for (auto const &segment : this->segments()) {
+            auto count = std::min(left, static_cast<usize>(segment.iov_len));
+            if (count == 0U) {
+                break;
+            }
+
+            std::memcpy(cursor, segment.iov_base, count);
+            cursor += count;
+            left -= count;
+        }
+
+        return (target.length() - left);
+    }
+
+    auto inline BufferChain::segments() const noexcept -> std::span<IoVec const>
+    {
+        return (std::span<IoVec const> { m_segments }.subspan(m_first));
+    }
+
+    auto inline BufferChain::operator[](usize index) const -> BufferRef
+    {
+        auto const &segment = m_segments.at(m_first + index);
+        return (BufferRef { segment.iov_base, segment.iov_len });
+    }
+
+    auto inline BufferChain::size() const noexcept -> usize
+    {
+        return (m_segments.size() - m_first);
+    }
+
+    auto inline BufferChain::length() const noexcept -> usize
+    {
+        return (m_length);
+    }
+
+    auto inline BufferChain::empty() const noexcept -> bool
+    {
+        return (m_length == 0U);
+    }
+}  // namespace memory
@@ -3,45 +3,200 @@
 // module includes
 #include "cascading_allocator.hpp"
 
+// c++ includes
+#include <bit>
+#include <new>
+#include <stdexcept>
+
 
 namespace memory
 {
+    // ============================================================================================== //
+    // Node storage ================================================================================= //
+    // ============================================================================================== //
+
     template <IsAllocator... Allocators>
-    auto CascadingAllocator<Allocators...>::alloc(usize size) -> Block
+    auto inline CascadingAllocator<Allocators...>::segment_of(usize index) noexcept -> usize
+    {
+        return (static_cast<usize>(std::bit_width((index / segment_base) + 1U)) - 1U);
+    }
+
+    template <IsAllocator... Allocators>
+    auto inline CascadingAllocator<Allocators...>::slot_at(usize index) const noexcept -> Node *
+    {
+        auto segment = self::segment_of(index);
+        auto offset  = index - (segment_base * ((usize { 1U } << segment) - 1U));
+
+        return (&m_segments[segment][offset]);
+    }
+
+    template <IsAllocator... Allocators>
+    auto inline CascadingAllocator<Allocators...>::node_at(usize index) noexcept -> Node *
+    {
+        if ((index >= m_size) || !this->slot_at(index)->allocator) {
+            return (nullptr);
+        }
+
+        return (this->slot_at(index));
+    }
+
+    template <IsAllocator... Allocators>
+    auto inline CascadingAllocator<Allocators...>::node_at(usize index) const noexcept -> Node const *
+    {
+        if ((index >= m_size) || !this->slot_at(index)->allocator) {
+            return (nullptr);
+        }
+
+        return (this->slot_at(index));
+    }
+
+    template <IsAllocator... Allocators>
+    auto CascadingAllocator<Allocators...>::grow() -> usize
+    {
+        auto index = max_nodes;
+
+        if (!m_vacant.empty()) {
+            index = m_vacant.back();
+            m_vacant.pop_back();
+        } else if (m_size < max_nodes) {
+            index = m_size;
+
+            auto segment = self::segment_of(index);
+            if (!m_segments[segment]) {
+                // every slot may become vacant, `release()` cannot allocate
+                m_vacant.reserve(segment_base * ((usize { 1U } << (segment + 1U)) - 1U));
+                m_segments[segment] = CreateScope<Node[]>(segment_base << segment);
+            }
+
+            m_size += 1U;
+        } else {
+            return (max_nodes);
+        }
+
+        auto *node = this->slot_at(index);
+
+        node->allocator.emplace();
+        node->live      = 0U;
+        node->exhausted = false;
+
+        return (index);
+    }
+
+    template <IsAllocator... Allocators>
+    auto CascadingAllocator<Allocators...>::release(usize index) noexcept -> void
+    {
+        auto *node = this->node_at(index);
+        if (node == nullptr) {
+            return;
+        }
+
+        node->allocator.reset();
+        m_vacant.push_back(index);
+
+        if (m_last == index) {
+            m_last = max_nodes;
+        }
+    }
+
+    template <IsAllocator... Allocators>
+    auto CascadingAllocator<Allocators...>::try_alloc(usize index, usize size) -> Block
     {
-        if (m_list.empty()) {
+        auto &node  = *this->node_at(index);
+        auto result = std::visit([size](auto &&arg) { return (arg.alloc(size)); }, *node.allocator);
+
+        if (result == null_block) {
+            // an empty node failing means the request does not fit at all
+            if (node.live > 0U) {
+                node.exhausted = true;
+            }
+
             return (null_block);
         }
 
-        Block result {};
-        for (auto &node : m_list) {
-            result = std::visit([size](auto &&arg) { return (arg.alloc(size)); }, node.first);
+        try {
+            m_index.insert(result, index);
+        } catch (std::bad_alloc const &) {
+            std::visit([&result](auto &&arg) { arg.free(result); }, *node.allocator);
+            return (null_block);
+        }
+
+        node.live += 1U;
+        m_last = index;
+
+        return (result);
+    }
+
+    // ============================================================================================== //
+    // CascadingAllocator implementation ============================================================ //
+    // ============================================================================================== //
+
+    template <IsAllocator... Allocators>
+    auto CascadingAllocator<Allocators...>::alloc(usize size) -> Block
+    {
+        if (auto const *node = this->node_at(m_last); (node != nullptr) && !node->exhausted) {
+            auto result = this->try_alloc(m_last, size);
+            if (result != null_block) {
+                return (result);
+            }
+        }
+
+        auto last = m_last;
+        for (auto index = usize { 0U }; index < m_size; ++index) {
+            if (index == last) {
+                continue;
+            }
 
-            if (result == null_block) {
-                break;
+            // exhausted nodes only drain until they are released
+            auto const *node = this->node_at(index);
+            if ((node == nullptr) || node->exhausted) {
+                continue;
             }
-            if (!node.second) {
-                break;
+
+            auto result = this->try_alloc(index, size);
+            if (result != null_block) {
+                return (result);
             }
         }
 
+        auto index = this->grow();
+        if (index == max_nodes) {
+            return (null_block);
+        }
+
+        auto result = this->try_alloc(index, size);
+        if (result == null_block) {
+            this->release(index);
+        }
+
         return (result);
     }
 
     template <IsAllocator... Allocators>
     auto CascadingAllocator<Allocators...>::owns(Block &block) const noexcept -> bool
     {
-        if (m_list.empty()) {
+        if (this->nodes() == 0U) {
             return (block == null_block);
         }
 
-        for (auto &node : m_list) {
-            auto owned = std::visit([&block](auto &&arg) -> bool { return (arg.owns(block)); }, node);
-            if (!node.second) {
-                return (false);
+        // the index only proves a block is foreign, a page may be shared with other allocators
+        auto owner = m_index.find(block);
+        if (owner == PageMap::none) {
+            return (false);
+        }
+
+        if (auto const *node = this->node_at(owner)) {
+            return (std::visit([&block](auto &&arg) -> bool { return (arg.owns(block)); }, *node->allocator));
+        }
+
+        for (auto index = usize { 0U }; index < m_size; ++index) {
+            auto const *node = this->node_at(index);
+            if (node == nullptr) {
+                continue;
             }
 
-            return (owned);
+            if (std::visit([&block](auto &&arg) -> bool { return (arg.owns(block)); }, *node->allocator)) {
+                return (true);
+            }
         }
 
         return (false);
@@ -50,20 +205,45 @@ namespace memory
     template <IsAllocator... Allocators>
     auto CascadingAllocator<Allocators...>::free(Block &block) -> void
     {
-        if (m_list.empty() && (block != null_block)) {
-            throw std::runtime_error("Cannot free block not owned by any known allocators");
+        if (block == null_block) {
+            return;
         }
 
-        for (auto &node : m_list) {
-            auto owned = std::visit([&block](auto &&arg) { return (arg.owns(block)); }, node.first);
+        auto index = m_index.find(block);
 
-            if (owned) {
-                std::visit([&block](auto &&arg) { arg.free(block); }, node.first);
-            }
+        if (this->node_at(index) == nullptr) {
+            index = max_nodes;
+
+            for (auto i = usize { 0U }; i < m_size; ++i) {
+                auto const *node = this->node_at(i);
+                if (node == nullptr) {
+                    continue;
+                }
 
-            if (!node.second) {
-                break;
+                if (std::visit([&block](auto &&arg) -> bool { return (arg.owns(block)); }, *node->allocator)) {
+                    index = i;
+                    break;
+                }
             }
         }
+
+        auto *node = this->node_at(index);
+        if (node == nullptr) {
+            throw std::runtime_error("Cannot free block not owned by any known allocators");
+        }
+
+        m_index.erase(block);
+        std::visit([&block](auto &&arg) { arg.free(block); }, *node->allocator);
+
+        node->live -= 1U;
+        if ((node->live == 0U) && node->exhausted) {
+            this->release(index);
+        }
+    }
+
+    template <IsAllocator... Allocators>
+    auto CascadingAllocator<Allocators...>::nodes() const noexcept -> usize
+    {
+        return (m_size - m_vacant.size());
     }
 }  // namespace memory
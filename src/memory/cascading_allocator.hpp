@@ -5,28 +5,88 @@
 // module includes
 #include "allocator_interface.hpp"
 #include "block.hpp"
+#include "page_map.hpp"
 #include "util/util.hpp"
 #include "utils.hpp"
 
 // c++ includes
-#include <list>
-#include <utility>
+#include <array>
+#include <optional>
 #include <variant>
+#include <vector>
 
 
 namespace memory
 {
+    /**
+     * Grows a cascade of allocators on demand
+     *
+     * When no node can serve a request a new one is appended, default
+     * constructing the first alternative of `Allocators`. Nodes live in
+     * segments doubling in size, so the cascade is walked over contiguous
+     * memory while node addresses stay stable for allocators pointing into
+     * themselves.
+     *
+     * Allocation first retries the node which served last. A node which failed
+     * an allocation is exhausted and is destroyed once all of its blocks are
+     * freed, its slot is reused by the next growth.
+     *
+     * @tparam Allocators node alternatives
+     */
     template <IsAllocator... Allocators>
-    class CascadingAllocator: public AllocatorInterface
+    class CascadingAllocator: private NonCopyable
     {
     private:
-        using Node = std::pair<std::variant<Allocators...>, bool>;
+        using self = CascadingAllocator<Allocators...>;
 
-        std::list<Node> m_list;
+        struct Node
+        {
+            /** Empty while the slot is vacant */
+            std::optional<std::variant<Allocators...>> allocator;
+            /** Blocks handed out and not yet freed */
+            usize live;
+            /** Set once the node failed an allocation */
+            bool exhausted;
+        };
+
+        usize static constexpr const segment_base { 4U };
+        usize static constexpr const segment_count { 14U };
+        usize static constexpr const max_nodes { segment_base * ((usize { 1U } << segment_count) - 1U) };
+
+        static_assert(max_nodes < PageMap::ambiguous, "node indices must fit the page map");
+
+        /** Segment `k` holds `segment_base << k` nodes */
+        std::array<Scope<Node[]>, segment_count> m_segments {};
+
+        /** Slots in use or vacant, the high-water mark of the cascade */
+        usize m_size { 0U };
+        /** Vacant slots below `m_size`, reserved for every allocated slot */
+        std::vector<usize> m_vacant {};
+        /** Node which served the last allocation */
+        usize m_last { max_nodes };
+
+        /** Routes live blocks to the node that served them, by slot index */
+        PageMap m_index;
+
+        auto static inline segment_of(usize index) noexcept -> usize;
+
+        /** Slot `index` below `m_size`, vacant or not */
+        auto inline slot_at(usize index) const noexcept -> Node *;
+
+        /** Live node `index`, or `nullptr` if out of range or vacant */
+        auto inline node_at(usize index) noexcept -> Node *;
+        auto inline node_at(usize index) const noexcept -> Node const *;
+
+        auto try_alloc(usize index, usize size) -> Block;
+        auto grow() -> usize;
+        auto release(usize index) noexcept -> void;
 
     public:
-        auto alloc(usize size) -> Block override;
-        auto owns(Block &block) const noexcept -> bool override;
-        auto free(Block &block) -> void override;
+        auto alloc(usize size) -> Block;
+        auto owns(Block &block) const noexcept -> bool;
+        auto free(Block &block) -> void;
+
+        /** Amount of live nodes */
+        [[nodiscard]] auto nodes() const noexcept -> usize;
     };
 }  // namespace memory
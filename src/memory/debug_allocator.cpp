@@ -0,0 +1,330 @@
+/** @file debug_allocator.cpp */
+
+// module includes
+#include "debug_allocator.hpp"
+
+#if MEMORY_DEBUG
+
+// module includes
+#include "page_allocator.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// logging
+#include "spdlog/spdlog.h"
+
+// clang-format off
+#if defined(__SANITIZE_ADDRESS__)
+    #define MEMORY_ASAN 1
+#elif defined(__has_feature)
+    #if __has_feature(address_sanitizer)
+        #define MEMORY_ASAN 1
+    #endif
+#endif
+
+#if defined(MEMORY_ASAN)
+    #include <sanitizer/asan_interface.h>
+
+    #define MEMORY_POISON(range)   ASAN_POISON_MEMORY_REGION((range).addr, (range).size)
+    #define MEMORY_UNPOISON(range) ASAN_UNPOISON_MEMORY_REGION((range).addr, (range).size)
+#else
+    #define MEMORY_POISON(range)   ((void)(range))
+    #define MEMORY_UNPOISON(range) ((void)(range))
+#endif
+// clang-format on
+
+namespace memory::detail
+{
+    auto static fill(Block const &range, u8 pattern) noexcept -> void
+    {
+        std::memset(range.addr, pattern, range.size);
+    }
+
+    auto static intact(Block const &range, u8 pattern) noexcept -> bool
+    {
+        auto const *first = static_cast<u8 *>(range);
+
+        return (std::all_of(first, first + range.size, [pattern](u8 byte) { return (byte == pattern); }));
+    }
+
+    auto static report(char const *what, Block const &block) -> void
+    {
+        auto message = fmt::format("MEM/ERROR: {} in block {} of {} B", what, fmt::ptr(block.addr), block.size);
+
+        spdlog::error(message);
+        throw std::runtime_error(message);
+    }
+}  // namespace memory::detail
+
+namespace memory
+{
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    template <IsAllocator Allocator, usize Quarantine, bool GuardPages>
+    DebugAllocator<Allocator, Quarantine, GuardPages>::~DebugAllocator()
+    {
+        if constexpr (Quarantine > 0U) {
+            auto count = std::min(m_quarantined, Quarantine);
+
+            // a corrupted block is reported, the others are still released
+            for (auto i = m_quarantined - count; i < m_quarantined; ++i) {
+                try {
+                    this->release(m_quarantine[i % Quarantine]);
+                } catch (std::exception const &error) {
+                    spdlog::error(fmt::format("MEM/ERROR: Quarantined block leaked on destruction, {}", error.what()));
+                }
+            }
+
+            m_quarantined = 0U;
+        }
+    }
+
+    // ============================================================================================== //
+    // Utility methods ============================================================================== //
+    // ============================================================================================== //
+
+    template <IsAllocator Allocator, usize Quarantine, bool GuardPages>
+    auto inline DebugAllocator<Allocator, Quarantine, GuardPages>::padded_of(Block const &block) noexcept
+        -> Block
+    {
+        Block padded { block.addr, block.size + DEBUG_REDZONE_SIZE };
+        return (padded);
+    }
+
+    template <IsAllocator Allocator, usize Quarantine, bool GuardPages>
+    auto inline DebugAllocator<Allocator, Quarantine, GuardPages>::trailer_of(Block const &block) noexcept
+        -> Block
+    {
+        Block trailer { static_cast<u8 *>(block) + block.size + DEBUG_REDZONE_SIZE, sizeof(usize) };
+        return (trailer);
+    }
+
+    template <IsAllocator Allocator, usize Quarantine, bool GuardPages>
+    auto inline DebugAllocator<Allocator, Quarantine, GuardPages>::upstream_of(Block const &block) noexcept
+        -> Block
+    {
+        auto trailer = self::trailer_of(block);
+        MEMORY_UNPOISON(trailer);
+
+        // the trailer may be unaligned for `usize`
+        Block upstream { block.addr, 0U };
+        std::memcpy(&upstream.size, trailer.addr, sizeof(usize));
+
+        return (upstream);
+    }
+
+    template <IsAllocator Allocator, usize Quarantine, bool GuardPages>
+    auto inline DebugAllocator<Allocator, Quarantine, GuardPages>::redzone_of(Block const &block) noexcept
+        -> Block
+    {
+        auto *end = static_cast<u8 *>(block) + block.size;
+
+        if constexpr (GuardPages) {
+            // the guard page starts at the next page boundary
+            auto page  = detail::page_size();
+            auto guard = (reinterpret_cast<uintptr>(end) + page - 1U) & ~(page - 1U);
+
+            Block redzone { end, static_cast<usize>(guard - reinterpret_cast<uintptr>(end)) };
+            return (redzone);
+        } else {
+            Block redzone { end, DEBUG_REDZONE_SIZE };
+            return (redzone);
+        }
+    }
+
+    template <IsAllocator Allocator, usize Quarantine, bool GuardPages>
+    auto DebugAllocator<Allocator, Quarantine, GuardPages>::map_guarded(usize size) -> Block
+    {
+        auto page = detail::page_size();
+        auto data = detail::page_round(size, PageHint::None);
+
+        auto *base = static_cast<u8 *>(detail::map_pages(data + page, PageHint::None, true));
+        if (base == nullptr) {
+            return (null_block);
+        }
+
+        detail::decommit_pages(base + data, page);
+
+        // place the block against the guard, as close as alignment allows
+        Block block { base + data - align_size<WORD_ALIGN>(size), size };
+        return (block);
+    }
+
+    template <IsAllocator Allocator, usize Quarantine, bool GuardPages>
+    auto DebugAllocator<Allocator, Quarantine, GuardPages>::unmap_guarded(Block const &block) noexcept -> void
+    {
+        auto page = detail::page_size();
+        auto base = reinterpret_cast<uintptr>(block.addr) & ~(page - 1U);
+
+        detail::unmap_pages(reinterpret_cast<void *>(base), detail::page_round(block.size, PageHint::None) + page);
+    }
+
+    template <IsAllocator Allocator, usize Quarantine, bool GuardPages>
+    auto DebugAllocator<Allocator, Quarantine, GuardPages>::check(Block const &block) const -> void
+    {
+        if constexpr (Quarantine > 0U) {
+            auto count = std::min(m_quarantined, Quarantine);
+            auto found = std::any_of(m_quarantine.begin(), m_quarantine.begin() + count,
+                                     [&block](Block const &held) { return (held.addr == block.addr); });
+
+            if (found) {
+                detail::report("double free", block);
+            }
+        }
+
+        if constexpr (GuardPages) {
+            if (m_guarded.find(block) != 0U) {
+                detail::report("free of a foreign block", block);
+            }
+        }
+
+        auto redzone = self::redzone_of(block);
+        MEMORY_UNPOISON(redzone);
+
+        if (!detail::intact(redzone, DEBUG_REDZONE_PATTERN)) {
+            detail::report("overrun", block);
+        }
+    }
+
+    template <IsAllocator Allocator, usize Quarantine, bool GuardPages>
+    auto DebugAllocator<Allocator, Quarantine, GuardPages>::release(Block &block) -> void
+    {
+        if constexpr (GuardPages) {
+            this->unmap_guarded(block);
+        } else {
+            auto upstream = self::upstream_of(block);
+            MEMORY_UNPOISON(upstream);
+
+            if (!detail::intact(self::padded_of(block), DEBUG_FREE_PATTERN)) {
+                detail::report("write after free", block);
+            }
+
+            // hand back exactly what was granted, which may exceed the request
+            m_allocator.free(upstream);
+        }
+
+        block = null_block;
+    }
+
+    template <IsAllocator Allocator, usize Quarantine, bool GuardPages>
+    auto DebugAllocator<Allocator, Quarantine, GuardPages>::flush() -> void
+    {
+        if constexpr (Quarantine > 0U) {
+            auto count = std::min(m_quarantined, Quarantine);
+
+            for (auto i = m_quarantined - count; i < m_quarantined; ++i) {
+                this->release(m_quarantine[i % Quarantine]);
+            }
+
+            m_quarantined = 0U;
+        }
+    }
+
+    template <IsAllocator Allocator, usize Quarantine, bool GuardPages>
+    auto inline DebugAllocator<Allocator, Quarantine, GuardPages>::get_allocator() noexcept -> Allocator &
+    {
+        return (m_allocator);
+    }
+
+    // ============================================================================================== //
+    // DebugAllocator implementation ================================================================ //
+    // ============================================================================================== //
+
+    template <IsAllocator Allocator, usize Quarantine, bool GuardPages>
+    auto DebugAllocator<Allocator, Quarantine, GuardPages>::alloc(usize size) -> Block
+    {
+        if (size == 0U) {
+            return (null_block);
+        }
+
+        auto block = null_block;
+
+        if constexpr (GuardPages) {
+            block = this->map_guarded(size);
+            if (block == null_block) {
+                return (null_block);
+            }
+
+            m_guarded.insert(block, 0U);
+        } else {
+            auto upstream = m_allocator.alloc(size + DEBUG_REDZONE_SIZE + sizeof(usize));
+            if (upstream == null_block) {
+                return (null_block);
+            }
+
+            block = Block { upstream.addr, size };
+            MEMORY_UNPOISON(upstream);
+
+            auto trailer = self::trailer_of(block);
+            std::memcpy(trailer.addr, &upstream.size, sizeof(usize));
+            MEMORY_POISON(trailer);
+        }
+
+        auto redzone = self::redzone_of(block);
+
+        detail::fill(block, DEBUG_ALLOC_PATTERN);
+        detail::fill(redzone, DEBUG_REDZONE_PATTERN);
+        MEMORY_POISON(redzone);
+
+        return (block);
+    }
+
+    template <IsAllocator Allocator, usize Quarantine, bool GuardPages>
+    auto DebugAllocator<Allocator, Quarantine, GuardPages>::owns(Block &block) const noexcept -> bool
+    {
+        if constexpr (GuardPages) {
+            return ((block.addr != nullptr) && (m_guarded.find(block) == 0U));
+        } else {
+            // the trailer of a foreign block is not ours to read
+            Block requested { block.addr, block.size + DEBUG_REDZONE_SIZE + sizeof(usize) };
+
+            return (m_allocator.owns(requested));
+        }
+    }
+
+    template <IsAllocator Allocator, usize Quarantine, bool GuardPages>
+    auto DebugAllocator<Allocator, Quarantine, GuardPages>::free(Block &block) -> void
+    {
+        if (block.addr == nullptr) {
+            return;
+        }
+
+        this->check(block);
+
+        if constexpr (GuardPages) {
+            // any access while quarantined faults
+            auto page = detail::page_size();
+            auto base = reinterpret_cast<uintptr>(block.addr) & ~(page - 1U);
+
+            m_guarded.erase(block);
+            detail::decommit_pages(reinterpret_cast<void *>(base), detail::page_round(block.size, PageHint::None));
+        } else {
+            auto padded = self::padded_of(block);
+
+            detail::fill(padded, DEBUG_FREE_PATTERN);
+            MEMORY_POISON(padded);
+        }
+
+        auto freed = block;
+        block      = null_block;
+
+        if constexpr (Quarantine > 0U) {
+            auto &slot = m_quarantine[m_quarantined % Quarantine];
+            if (m_quarantined >= Quarantine) {
+                this->release(slot);
+            }
+
+            slot = freed;
+            m_quarantined += 1U;
+        } else {
+            this->release(freed);
+        }
+    }
+}  // namespace memory
+
+#endif
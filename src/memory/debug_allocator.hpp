@@ -0,0 +1,108 @@
+/** @file debug_allocator.hpp */
+
+#pragma once
+
+// module includes
+#include "allocator_interface.hpp"
+#include "block.hpp"
+#include "page_map.hpp"
+#include "util/util.hpp"
+#include "utils.hpp"
+
+// c++ includes
+#include <array>
+
+// clang-format off
+#if !defined(MEMORY_DEBUG)
+    #if defined(NDEBUG)
+        #define MEMORY_DEBUG 0
+    #else
+        #define MEMORY_DEBUG 1
+    #endif
+#endif
+// clang-format on
+
+
+namespace memory
+{
+    /** Written over freshly allocated memory */
+    u8 static constexpr const DEBUG_ALLOC_PATTERN = { 0xCDU };
+    /** Written over freed memory while it sits in quarantine */
+    u8 static constexpr const DEBUG_FREE_PATTERN = { 0xDDU };
+    /** Written between the end of a block and its guard */
+    u8 static constexpr const DEBUG_REDZONE_PATTERN = { 0xFDU };
+    /** Bytes appended to every block when guard pages are off */
+    usize static constexpr const DEBUG_REDZONE_SIZE = { 16U };
+
+#if MEMORY_DEBUG
+    /**
+     * Decorator catching overruns and use-after-free of the wrapped allocator
+     *
+     * Fresh blocks are filled with `DEBUG_ALLOC_PATTERN` and followed by a
+     * redzone. Freed blocks are filled with `DEBUG_FREE_PATTERN` and held in
+     * a quarantine of `Quarantine` blocks before going back upstream, with
+     * the size `Allocator` granted kept in a trailer after the redzone. Writes
+     * to either are reported when the block leaves. Under ASan both are
+     * poisoned as well, so the faulting access is reported right away.
+     *
+     * With `GuardPages` every block gets its own mapping, ending right before
+     * an inaccessible page, and quarantined blocks are made inaccessible. Then
+     * overruns and use-after-free fault at the offending instruction without
+     * ASan. These blocks bypass `Allocator` completely.
+     *
+     * Builds defining `NDEBUG`, or `MEMORY_DEBUG=0`, alias this to `Allocator`.
+     *
+     * @tparam Allocator wrapped allocator
+     * @tparam Quarantine amount of freed blocks held back
+     * @tparam GuardPages serve blocks from guarded page mappings
+     */
+    template <IsAllocator Allocator, usize Quarantine = 64U, bool GuardPages = false>
+    class DebugAllocator: private NonCopyable
+    {
+    private:
+        using self = DebugAllocator<Allocator, Quarantine, GuardPages>;
+
+        Allocator m_allocator {};
+
+        /** Freed blocks waiting to be released, oldest at `m_quarantined % Quarantine` */
+        std::array<Block, Quarantine> m_quarantine {};
+        usize m_quarantined { 0U };
+
+        /** Live guarded blocks, all registered as owner `0` */
+        PageMap m_guarded {};
+
+        auto static inline padded_of(Block const &block) noexcept -> Block;
+        auto static inline trailer_of(Block const &block) noexcept -> Block;
+        auto static inline upstream_of(Block const &block) noexcept -> Block;
+        auto static inline redzone_of(Block const &block) noexcept -> Block;
+
+        auto map_guarded(usize size) -> Block;
+        auto unmap_guarded(Block const &block) noexcept -> void;
+
+        auto check(Block const &block) const -> void;
+        auto release(Block &block) -> void;
+
+    public:
+        using allocator_type = Allocator;
+
+        usize static constexpr const quarantine { Quarantine };
+        bool static constexpr const guard_pages { GuardPages };
+
+        DebugAllocator() = default;
+        ~DebugAllocator();
+
+        auto alloc(usize size) -> Block;
+        auto owns(Block &block) const noexcept -> bool;
+        auto free(Block &block) -> void;
+
+        /** Releases every quarantined block */
+        auto flush() -> void;
+
+        /** Provides access to the wrapped allocator */
+        auto inline get_allocator() noexcept -> Allocator &;
+    };
+#else
+    template <IsAllocator Allocator, usize Quarantine = 64U, bool GuardPages = false>
+    using DebugAllocator = Allocator;
+#endif
+}  // namespace memory
@@ -3,44 +3,172 @@
 // module includes
 #include "fallback_allocator.hpp"
 
+// c++ includes
+#include <new>
+
 namespace memory
 {
-    template <IsAllocator Primary, IsAllocator Secondary>
-    auto FallbackAllocator<Primary, Secondary>::alloc(usize size) -> Block
+    template <IsAllocator Primary, IsAllocator Secondary, bool Indexed>
+    auto FallbackAllocator<Primary, Secondary, Indexed>::owner_of(Block const &block) const noexcept -> usize
+    {
+        auto owner = PageMap::none;
+        if constexpr (Indexed) {
+            owner = m_index.pages.find(block);
+        }
+
+        if ((owner != primary_index) && (owner != secondary_index)) {
+            auto copy = block;
+            owner     = m_primary.owns(copy) ? primary_index : secondary_index;
+        }
+
+        return (owner);
+    }
+
+    template <IsAllocator Primary, IsAllocator Secondary, bool Indexed>
+    auto FallbackAllocator<Primary, Secondary, Indexed>::track(Block &block, usize owner) -> bool
+    {
+        if constexpr (Indexed) {
+            try {
+                m_index.pages.insert(block, owner);
+            } catch (std::bad_alloc const &) {
+                if (owner == primary_index) {
+                    m_primary.free(block);
+                } else {
+                    m_secondary.free(block);
+                }
+
+                block = null_block;
+                return (false);
+            }
+        }
+
+        return (true);
+    }
+
+    template <IsAllocator Primary, IsAllocator Secondary, bool Indexed>
+    auto FallbackAllocator<Primary, Secondary, Indexed>::alloc(usize size) -> Block
     {
         auto block = m_primary.alloc(size);
         if (block.addr != nullptr) {
+            this->track(block, primary_index);
+
             return (block);
-        } else {
-            return (m_secondary.alloc(size));
         }
+
+        block = m_secondary.alloc(size);
+        if (block.addr != nullptr) {
+            this->track(block, secondary_index);
+        }
+
+        return (block);
     }
 
-    template <IsAllocator Primary, IsAllocator Secondary>
-    auto FallbackAllocator<Primary, Secondary>::owns(Block &block) const noexcept -> bool
+    template <IsAllocator Primary, IsAllocator Secondary, bool Indexed>
+    auto FallbackAllocator<Primary, Secondary, Indexed>::owns(Block &block) const noexcept -> bool
     {
+        if constexpr (Indexed) {
+            // the index only proves a block is foreign, a page may be shared with other allocators
+            switch (m_index.pages.find(block)) {
+            case PageMap::none: {
+                if (m_index.complete) {
+                    return (false);
+                }
+            } break;
+            case primary_index: return (m_primary.owns(block));
+            case secondary_index: return (m_secondary.owns(block));
+            default: break;
+            }
+        }
+
         return (m_primary.owns(block) || m_secondary.owns(block));
     }
 
-    template <IsAllocator Primary, IsAllocator Secondary>
-    auto FallbackAllocator<Primary, Secondary>::free(Block &block) -> void
+    template <IsAllocator Primary, IsAllocator Secondary, bool Indexed>
+    auto FallbackAllocator<Primary, Secondary, Indexed>::free(Block &block) -> void
     {
-        if (m_primary.owns(block)) {
+        auto owner = this->owner_of(block);
+
+        if constexpr (Indexed) {
+            m_index.pages.erase(block);
+        }
+
+        if (owner == primary_index) {
             m_primary.free(block);
         } else {
             m_secondary.free(block);
         }
     }
-    template <IsAllocator Primary, IsAllocator Secondary>
-    auto inline FallbackAllocator<Primary, Secondary>::get_primary() noexcept -> Primary &
+
+    template <IsAllocator Primary, IsAllocator Secondary, bool Indexed>
+    auto FallbackAllocator<Primary, Secondary, Indexed>::expand(Block &block, usize delta) -> bool
+    {
+        if (block.addr == nullptr) {
+            return (false);
+        }
+
+        auto owner    = this->owner_of(block);
+        auto original = block;
+
+        auto expanded = (owner == primary_index) ? memory::expand(m_primary, block, delta)
+                                                 : memory::expand(m_secondary, block, delta);
+
+        // the grown block may touch new pages
+        if constexpr (Indexed) {
+            if (expanded) {
+                this->reindex(original, block, owner);
+            }
+        }
+
+        return (expanded);
+    }
+
+    template <IsAllocator Primary, IsAllocator Secondary, bool Indexed>
+    auto FallbackAllocator<Primary, Secondary, Indexed>::reallocate(Block &block, usize new_size) -> bool
+    {
+        if ((block.addr == nullptr) || (new_size == 0U)) {
+            return (memory::reallocate_by_copy(*this, block, new_size));
+        }
+
+        auto owner    = this->owner_of(block);
+        auto original = block;
+
+        // let the owner resize or move the block first, then move it across children
+        auto resized = (owner == primary_index) ? memory::reallocate(m_primary, block, new_size)
+                                                : memory::reallocate(m_secondary, block, new_size);
+
+        if constexpr (Indexed) {
+            if (resized) {
+                this->reindex(original, block, owner);
+            }
+        }
+
+        return (resized || memory::reallocate_by_copy(*this, block, new_size));
+    }
+
+    template <IsAllocator Primary, IsAllocator Secondary, bool Indexed>
+    auto FallbackAllocator<Primary, Secondary, Indexed>::reindex(Block const &original, Block const &resized,
+                                                                 usize owner) noexcept -> void
+    {
+        // the new range goes in first, so the pages both share are never unregistered
+        try {
+            m_index.pages.insert(resized, owner);
+        } catch (std::bad_alloc const &) {
+            // a stale registration could misroute other blocks, drop it and stop trusting `none`
+            m_index.complete = false;
+        }
+
+        m_index.pages.erase(original);
+    }
+
+    template <IsAllocator Primary, IsAllocator Secondary, bool Indexed>
+    auto inline FallbackAllocator<Primary, Secondary, Indexed>::get_primary() noexcept -> Primary &
     {
         return (m_primary);
     }
 
-    template <IsAllocator Primary, IsAllocator Secondary>
-    auto inline FallbackAllocator<Primary, Secondary>::get_secondary() noexcept -> Secondary &
+    template <IsAllocator Primary, IsAllocator Secondary, bool Indexed>
+    auto inline FallbackAllocator<Primary, Secondary, Indexed>::get_secondary() noexcept -> Secondary &
     {
         return (m_secondary);
     }
-
 }  // namespace memory
@@ -5,26 +5,67 @@
 // module includes
 #include "allocator_interface.hpp"
 #include "block.hpp"
+#include "page_map.hpp"
 #include "util/util.hpp"
 #include "utils.hpp"
 
+// c++ includes
+#include <type_traits>
+#include <variant>
+
 
 namespace memory
 {
-    template <IsAllocator Primary, IsAllocator Secondary>
-    class FallbackAllocator final: public AllocatorInterface
+    /**
+     * Serves from `Primary`, and from `Secondary` whatever `Primary` cannot
+     *
+     * Ownership is resolved by asking `Primary`. With `Indexed`, live blocks
+     * are recorded in a `PageMap` instead, which allocates its levels from the
+     * heap as blocks land in new address ranges. That only pays off when
+     * `Primary::owns()` is expensive, i.e. a composite itself.
+     *
+     * @tparam Primary allocator asked first
+     * @tparam Secondary allocator asked when `Primary` fails
+     * @tparam Indexed route blocks through a `PageMap`
+     */
+    template <IsAllocator Primary, IsAllocator Secondary, bool Indexed = false>
+    class FallbackAllocator final: private NonCopyable
     {
     private:
         Primary m_primary;
         Secondary m_secondary;
 
+        struct Index
+        {
+            /** Routes live blocks to the allocator that served them */
+            PageMap pages {};
+            /** Cleared once a resized block could not be indexed, unindexed pages stop proving anything */
+            bool complete { true };
+        };
+
+        [[no_unique_address]] std::conditional_t<Indexed, Index, std::monostate> m_index;
+
+        usize static constexpr const primary_index { 0U };
+        usize static constexpr const secondary_index { 1U };
+
+        /** Child serving `block`, asks `Primary` when the index cannot tell */
+        auto owner_of(Block const &block) const noexcept -> usize;
+
+        /** Indexes a block served by `owner`, handing it back if that fails */
+        auto track(Block &block, usize owner) -> bool;
+
+        /** Moves the registration of a block resized by `owner` */
+        auto reindex(Block const &original, Block const &resized, usize owner) noexcept -> void;
+
     public:
         using primary_allocator_type   = Primary;
         using secondary_allocator_type = Secondary;
 
-        auto alloc(usize size) -> Block override;
-        auto owns(Block &block) const noexcept -> bool override;
-        auto free(Block &block) -> void override;
+        auto alloc(usize size) -> Block;
+        auto owns(Block &block) const noexcept -> bool;
+        auto free(Block &block) -> void;
+        auto expand(Block &block, usize delta) -> bool;
+        auto reallocate(Block &block, usize new_size) -> bool;
 
         auto inline get_primary() noexcept -> Primary &;
         auto inline get_secondary() noexcept -> Secondary &;
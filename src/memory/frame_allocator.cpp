@@ -0,0 +1,163 @@
+/** @file frame_allocator.cpp */
+
+// module includes
+#include "frame_allocator.hpp"
+
+// c++ includes
+#include <new>
+
+namespace memory
+{
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    template <usize capacity, usize frames, usize align>
+    FrameAllocator<capacity, frames, align>::FrameAllocator(): m_storage { m_pages.alloc(stride * frames) }
+    {
+        if (m_storage == null_block) {
+            throw std::bad_alloc();
+        }
+
+        // mappings are page aligned, which covers `buf_align`
+        for (auto i = usize { 0U }; i < frames; ++i) {
+            m_frames[i].buf = static_cast<u8 *>(m_storage) + (i * stride);
+        }
+    }
+
+    template <usize capacity, usize frames, usize align>
+    FrameAllocator<capacity, frames, align>::~FrameAllocator()
+    {
+        m_pages.free(m_storage);
+    }
+
+    // ============================================================================================== //
+    // Utility methods ============================================================================== //
+    // ============================================================================================== //
+
+    template <usize capacity, usize frames, usize align>
+    auto inline FrameAllocator<capacity, frames, align>::current() noexcept -> Frame &
+    {
+        return (m_frames[m_current.load(std::memory_order_acquire)]);
+    }
+
+    template <usize capacity, usize frames, usize align>
+    auto inline FrameAllocator<capacity, frames, align>::current() const noexcept -> Frame const &
+    {
+        return (m_frames[m_current.load(std::memory_order_acquire)]);
+    }
+
+    template <usize capacity, usize frames, usize align>
+    auto FrameAllocator<capacity, frames, align>::next_frame() noexcept -> void
+    {
+        auto next = (m_current.load(std::memory_order_relaxed) + 1U) % frames;
+
+        m_frames[next].cursor.store(0U, std::memory_order_relaxed);
+        m_current.store(next, std::memory_order_release);
+    }
+
+    template <usize capacity, usize frames, usize align>
+    auto FrameAllocator<capacity, frames, align>::frame() const noexcept -> usize
+    {
+        return (m_current.load(std::memory_order_acquire));
+    }
+
+    template <usize capacity, usize frames, usize align>
+    auto FrameAllocator<capacity, frames, align>::used() const noexcept -> usize
+    {
+        return (std::min(this->current().cursor.load(std::memory_order_relaxed), capacity));
+    }
+
+    // ============================================================================================== //
+    // FrameAllocator implementation ================================================================ //
+    // ============================================================================================== //
+
+    template <usize capacity, usize frames, usize align>
+    auto FrameAllocator<capacity, frames, align>::alloc(usize size) -> Block
+    {
+        if ((size == 0U) || (size > capacity)) {
+            return (null_block);
+        }
+
+        auto &frame  = this->current();
+        auto aligned = align_size<align>(size);
+        auto offset  = frame.cursor.fetch_add(aligned, std::memory_order_relaxed);
+
+        if ((offset + aligned) > capacity) {
+            return (null_block);
+        }
+
+        Block block { frame.buf + offset, size };
+        return (block);
+    }
+
+    template <usize capacity, usize frames, usize align>
+    auto FrameAllocator<capacity, frames, align>::owns(Block &block) const noexcept -> bool
+    {
+        auto addr = reinterpret_cast<uintptr>(block.addr);
+
+        for (auto const &frame : m_frames) {
+            auto first = reinterpret_cast<uintptr>(frame.buf);
+            if ((first <= addr) && (addr < (first + capacity))) {
+                return (true);
+            }
+        }
+
+        return (false);
+    }
+
+    template <usize capacity, usize frames, usize align>
+    auto FrameAllocator<capacity, frames, align>::free(Block &block) -> void
+    {
+        if (!this->owns(block)) {
+            return;
+        }
+
+        // the topmost block of the current frame can be given back right away,
+        // anything else is reclaimed once its frame is recycled
+        auto &frame = this->current();
+        auto addr   = reinterpret_cast<u8 *>(block.addr);
+
+        if ((frame.buf <= addr) && (addr < (frame.buf + capacity))) {
+            auto offset  = static_cast<usize>(addr - frame.buf);
+            auto expects = offset + align_size<align>(block.size);
+
+            frame.cursor.compare_exchange_strong(expects, offset, std::memory_order_relaxed);
+        }
+
+        block = null_block;
+    }
+
+    template <usize capacity, usize frames, usize align>
+    auto FrameAllocator<capacity, frames, align>::expand(Block &block, usize delta) -> bool
+    {
+        auto &frame = this->current();
+        auto addr   = reinterpret_cast<u8 *>(block.addr);
+
+        if ((addr < frame.buf) || (addr >= (frame.buf + capacity))) {
+            return (false);
+        }
+
+        auto offset = static_cast<usize>(addr - frame.buf);
+        if (delta > (capacity - offset - block.size)) {
+            return (false);
+        }
+
+        auto desired = offset + align_size<align>(block.size + delta);
+        if (desired > capacity) {
+            return (false);
+        }
+
+        // succeeds only while the block is still the topmost one of the frame
+        auto expects = offset + align_size<align>(block.size);
+        if (!frame.cursor.compare_exchange_strong(expects, desired, std::memory_order_relaxed)) {
+            return (false);
+        }
+
+        block.size += delta;
+
+        return (true);
+    }
+
+    template class FrameAllocator<FRAME_CAPACITY, FRAME_COUNT>;
+}  // namespace memory
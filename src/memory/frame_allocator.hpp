@@ -0,0 +1,99 @@
+/** @file frame_allocator.hpp */
+
+#pragma once
+
+// module includes
+#include "allocator_interface.hpp"
+#include "block.hpp"
+#include "page_allocator.hpp"
+#include "util/util.hpp"
+#include "utils.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+
+namespace memory
+{
+    /** Capacity of a single frame in the engine's frame arena */
+    usize static constexpr const FRAME_CAPACITY = { 1024U * 1024U };
+
+    /** Amount of frames the engine's frame arena keeps alive */
+    usize static constexpr const FRAME_COUNT = { 2U };
+
+    /**
+     * Lock-free, multi-buffered linear arena for per-frame scratch memory
+     *
+     * Any thread may bump-allocate from the current frame through an atomic
+     * cursor. `next_frame()` rotates to the oldest frame and rewinds it in O(1),
+     * so data written during the last `frames - 1` frames stays readable.
+     *
+     * `next_frame()` must be called from a sync point (i.e. `Window::end_frame()`)
+     * once no thread is allocating from the frame being recycled.
+     *
+     * The frames share one `PageAllocator` mapping taken at construction, the
+     * arena itself only holds their cursors. Pages are backed on first touch.
+     *
+     * @tparam capacity size of each frame in bytes
+     * @tparam frames amount of frames kept alive, 2 for double buffering
+     * @tparam align alignment of every allocation
+     */
+    template <usize capacity, usize frames = FRAME_COUNT, usize align = WORD_ALIGN>
+    class FrameAllocator: private NonCopyable
+    {
+    private:
+        static_assert(frames > 0U, "at least one frame is required");
+        static_assert(is_power_of_two(align), "alignment must be power of two");
+
+        usize static constexpr const buf_align { std::max(align, CACHE_LINE_SIZE) };
+        usize static constexpr const stride { align_size<buf_align>(capacity) };
+
+        /** Single frame, the cursor lives on its own cache line */
+        struct Frame
+        {
+            alignas(CACHE_LINE_SIZE) std::atomic<usize> cursor { 0U };
+            u8 *buf { nullptr };
+        };
+
+        PageAllocator<> m_pages {};
+        /** Mapping holding every frame back to back */
+        Block m_storage { null_block };
+
+        std::array<Frame, frames> m_frames {};
+
+        alignas(CACHE_LINE_SIZE) std::atomic<usize> m_current { 0U };
+
+        auto inline current() noexcept -> Frame &;
+        auto inline current() const noexcept -> Frame const &;
+
+    public:
+        /** Maps the frames, throws `std::bad_alloc` if that fails */
+        FrameAllocator();
+        ~FrameAllocator();
+
+        usize static constexpr const frame_capacity { capacity };
+        usize static constexpr const frame_count { frames };
+        usize static constexpr const alignment { align };
+
+        /** Rotates to the oldest frame and rewinds it */
+        auto next_frame() noexcept -> void;
+
+        /** Index of the frame allocations are currently served from */
+        [[nodiscard]] auto frame() const noexcept -> usize;
+
+        /** Bytes allocated from the current frame */
+        [[nodiscard]] auto used() const noexcept -> usize;
+
+        auto alloc(usize size) -> Block;
+        auto owns(Block &block) const noexcept -> bool;
+        auto free(Block &block) -> void;
+        auto expand(Block &block, usize delta) -> bool;
+    };
+
+    /** Frame arena used by the engine, instantiated in `frame_allocator.cpp` */
+    using DefaultFrameAllocator = FrameAllocator<FRAME_CAPACITY, FRAME_COUNT>;
+
+    extern template class FrameAllocator<FRAME_CAPACITY, FRAME_COUNT>;
+}  // namespace memory
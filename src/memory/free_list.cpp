@@ -2,13 +2,17 @@
 
 // module includes
 #include "free_list.hpp"
-#include "memory/block.hpp"
-#include "memory/free_list.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <cstring>
+#include <new>
 
 namespace memory::detail
 {
     template <class T>
-    FreeListHelper<T>::iterator::iterator(T::Node *current): m_current(current)
+    FreeListHelper<T>::iterator::iterator(T::Slab *slab)
+        : m_slab(slab), m_current((slab != nullptr) ? slab->head : nullptr)
     {
     }
 
@@ -29,24 +33,27 @@ namespace memory::detail
     {
         m_current = (m_current != nullptr) ? (m_current->next) : (nullptr);
 
+        while ((m_current == nullptr) && (m_slab != nullptr)) {
+            m_slab    = m_slab->next;
+            m_current = (m_slab != nullptr) ? m_slab->head : nullptr;
+        }
+
         return (*this);
     }
 
     template <class T>
-    auto inline FreeListHelper<T>::iterator::operator++(i32 step) const noexcept -> iterator
+    auto inline FreeListHelper<T>::iterator::operator++(int) noexcept -> iterator
     {
-        iterator advanced = { m_current };
-        for (auto i = 0U; (i < step) && (advanced.m_current != nullptr); ++i) {
-            advanced++;
-        }
+        auto previous = *this;
+        ++(*this);
 
-        return (advanced);
+        return (previous);
     }
 
     template <class T>
     auto inline FreeListHelper<T>::iterator::operator*() const noexcept -> value_type
     {
-        return (m_current->block);
+        return (Block { m_current, T::max });
     }
 
     template <class T>
@@ -63,7 +70,7 @@ namespace memory::detail
     template <class T>
     auto FreeListHelper<T>::begin() -> iterator
     {
-        return (iterator { m_instance.m_head });
+        return (iterator { m_instance.m_partial });
     }
 
     template <class T>
@@ -75,66 +82,250 @@ namespace memory::detail
 
 namespace memory
 {
-    template <class Allocator, usize BS, usize Min, usize Max, usize Cap>
-    auto FreeList<Allocator, BS, Min, Max, Cap>::alloc(usize size) -> Block
-    {
-        if ((size >= Min) && (size <= Max)) {
-            if (m_head != nullptr) {
-                auto block = m_head->block;
-                m_head     = m_head->next;
-
-                return (block);
-            } else {
-                Block first { nullptr, 0U };
-
-                for (auto i = 0U; i < BS; ++i) {
-                    if (m_allocs++ == Cap) {
-                        break;
-                    }
-
-                    auto node_block = m_allocator.alloc(sizeof(Node) + Max);
-                    auto current    = reinterpret_cast<Node *>(node_block.addr);
-                    current->block  = { node_block + sizeof(Node), Max };
-
-                    if (i == 0U) {
-                        first = current->block;
-                    } else {
-                        current->next = m_head;
-                        m_head        = current;
-                    }
-                }
-
-                return (first);
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    template <class Allocator, usize BS, usize Min, usize Max, usize Cap, bool OutOfLine>
+    FreeList<Allocator, BS, Min, Max, Cap, OutOfLine>::~FreeList()
+    {
+        // blocks still handed out are invalidated with their slabs
+        for (auto *slab : m_slabs) {
+            auto block = slab->block;
+            m_allocator.free(block);
+        }
+    }
+
+    // ============================================================================================== //
+    // Slab management ============================================================================== //
+    // ============================================================================================== //
+
+    template <class Allocator, usize BS, usize Min, usize Max, usize Cap, bool OutOfLine>
+    auto inline FreeList<Allocator, BS, Min, Max, Cap, OutOfLine>::payload_of(Slab *slab, usize index) noexcept
+        -> u8 *
+    {
+        return (reinterpret_cast<u8 *>(slab) + slab_header + (index * stride) + header_size);
+    }
+
+    template <class Allocator, usize BS, usize Min, usize Max, usize Cap, bool OutOfLine>
+    auto FreeList<Allocator, BS, Min, Max, Cap, OutOfLine>::find_slab(void const *addr) const noexcept -> Slab *
+    {
+        auto *target = static_cast<u8 const *>(addr);
+
+        auto found = std::upper_bound(m_slabs.begin(), m_slabs.end(), target, [](u8 const *value, Slab *slab) {
+            return (value < reinterpret_cast<u8 const *>(slab));
+        });
+
+        if (found == m_slabs.begin()) {
+            return (nullptr);
+        }
+
+        auto *slab  = *std::prev(found);
+        auto *first = self::payload_of(slab, 0U);
+        if ((target < first) || (target >= self::payload_of(slab, slab->count))) {
+            return (nullptr);
+        }
+
+        // addresses inside a node are not blocks of ours either
+        if ((static_cast<usize>(target - first) % stride) != 0U) {
+            return (nullptr);
+        }
+
+        return (slab);
+    }
+
+    template <class Allocator, usize BS, usize Min, usize Max, usize Cap, bool OutOfLine>
+    auto FreeList<Allocator, BS, Min, Max, Cap, OutOfLine>::slab_of(Block const &block) const noexcept -> Slab *
+    {
+        if constexpr (OutOfLine) {
+            return (this->find_slab(block.addr));
+        } else {
+#if !defined(NDEBUG)
+            // a foreign block has no header, only trust it once the index agrees
+            auto *found = this->find_slab(block.addr);
+            if (found == nullptr) {
+                return (nullptr);
+            }
+#endif
+
+            Slab *slab { nullptr };
+            std::memcpy(&slab, static_cast<u8 *>(block) - header_size, sizeof(Slab *));
+
+#if !defined(NDEBUG)
+            if (slab != found) {
+                return (nullptr);
+            }
+#endif
+
+            return (slab);
+        }
+    }
+
+    template <class Allocator, usize BS, usize Min, usize Max, usize Cap, bool OutOfLine>
+    auto inline FreeList<Allocator, BS, Min, Max, Cap, OutOfLine>::link(Slab *slab) noexcept -> void
+    {
+        slab->prev = nullptr;
+        slab->next = m_partial;
+
+        if (m_partial != nullptr) {
+            m_partial->prev = slab;
+        }
+
+        m_partial = slab;
+    }
+
+    template <class Allocator, usize BS, usize Min, usize Max, usize Cap, bool OutOfLine>
+    auto inline FreeList<Allocator, BS, Min, Max, Cap, OutOfLine>::unlink(Slab *slab) noexcept -> void
+    {
+        if (slab->prev != nullptr) {
+            slab->prev->next = slab->next;
+        } else {
+            m_partial = slab->next;
+        }
+
+        if (slab->next != nullptr) {
+            slab->next->prev = slab->prev;
+        }
+
+        slab->prev = nullptr;
+        slab->next = nullptr;
+    }
+
+    template <class Allocator, usize BS, usize Min, usize Max, usize Cap, bool OutOfLine>
+    auto FreeList<Allocator, BS, Min, Max, Cap, OutOfLine>::refill() -> bool
+    {
+        if (m_spare != nullptr) {
+            this->link(m_spare);
+            m_spare = nullptr;
+
+            return (true);
+        }
+
+        auto count = std::min(BS, Cap - std::min(m_allocs, Cap));
+        if (count == 0U) {
+            return (false);
+        }
+
+        auto block = m_allocator.alloc(slab_header + (count * stride));
+        if (block == null_block) {
+            return (false);
+        }
+
+        SCOPE_FAIL
+        {
+            m_allocator.free(block);
+        };
+
+        auto *slab = new (block.addr) Slab { block, nullptr, nullptr, nullptr, count, count };
+
+        for (auto i = count; i-- > 0U;) {
+            auto *payload = self::payload_of(slab, i);
+
+            if constexpr (!OutOfLine) {
+                std::memcpy(payload - header_size, &slab, sizeof(Slab *));
             }
+
+            auto *node = new (payload) Node { slab->head };
+            slab->head = node;
         }
 
-        return (null_block);
+        m_slabs.insert(std::upper_bound(m_slabs.begin(), m_slabs.end(), slab), slab);
+        m_allocs += count;
+
+        this->link(slab);
+
+        return (true);
     }
 
-    template <class Allocator, usize BS, usize Min, usize Max, usize Cap>
-    auto FreeList<Allocator, BS, Min, Max, Cap>::owns(Block &block) const noexcept -> bool
+    template <class Allocator, usize BS, usize Min, usize Max, usize Cap, bool OutOfLine>
+    auto FreeList<Allocator, BS, Min, Max, Cap, OutOfLine>::release(Slab *slab) -> void
+    {
+        auto found = std::lower_bound(m_slabs.begin(), m_slabs.end(), slab);
+        if ((found != m_slabs.end()) && (*found == slab)) {
+            m_slabs.erase(found);
+        }
+
+        m_allocs -= slab->count;
+
+        auto block = slab->block;
+        m_allocator.free(block);
+    }
+
+    template <class Allocator, usize BS, usize Min, usize Max, usize Cap, bool OutOfLine>
+    auto FreeList<Allocator, BS, Min, Max, Cap, OutOfLine>::slabs() const noexcept -> usize
+    {
+        return (m_slabs.size());
+    }
+
+    // ============================================================================================== //
+    // FreeList implementation ====================================================================== //
+    // ============================================================================================== //
+
+    template <class Allocator, usize BS, usize Min, usize Max, usize Cap, bool OutOfLine>
+    auto FreeList<Allocator, BS, Min, Max, Cap, OutOfLine>::alloc(usize size) -> Block
+    {
+        if ((size < Min) || (size > Max)) {
+            return (null_block);
+        }
+
+        if ((m_partial == nullptr) && !this->refill()) {
+            return (null_block);
+        }
+
+        auto *slab = m_partial;
+        auto *node = slab->head;
+
+        slab->head = node->next;
+        slab->free -= 1U;
+
+        if (slab->free == 0U) {
+            this->unlink(slab);
+        }
+
+        Block block { node, Max };
+        return (block);
+    }
+
+    template <class Allocator, usize BS, usize Min, usize Max, usize Cap, bool OutOfLine>
+    auto FreeList<Allocator, BS, Min, Max, Cap, OutOfLine>::owns(Block &block) const noexcept -> bool
     {
         if ((block.size >= Min) && (block.size <= Max)) {
-            return (m_allocator.owns(block));
+            return (this->find_slab(block.addr) != nullptr);
         }
 
         return (false);
     }
 
-    template <class Allocator, usize BS, usize Min, usize Max, usize Cap>
-    auto FreeList<Allocator, BS, Min, Max, Cap>::free(Block &block) -> void
+    template <class Allocator, usize BS, usize Min, usize Max, usize Cap, bool OutOfLine>
+    auto FreeList<Allocator, BS, Min, Max, Cap, OutOfLine>::free(Block &block) -> void
     {
-        if (this->owns(block)) {
-            // clang-format off
-            auto current = reinterpret_cast<Node *>(
-                reinterpret_cast<u8 *>(block.addr) - sizeof(Node)
-            );
-            // clang-format on
+        if ((block.addr == nullptr) || (block.size < Min) || (block.size > Max)) {
+            return;
+        }
 
-            current->next = m_head;
-            m_head        = current;
+        auto *slab = this->slab_of(block);
+        if (slab == nullptr) {
+            return;
+        }
+
+        slab->head = new (block.addr) Node { slab->head };
+        slab->free += 1U;
 
-            block = null_block;
+        if (slab->free == 1U) {
+            this->link(slab);
         }
+
+        // hand whole slabs back, keeping the latest one to absorb churn
+        if (slab->free == slab->count) {
+            this->unlink(slab);
+
+            if (m_spare != nullptr) {
+                this->release(m_spare);
+            }
+
+            m_spare = slab;
+        }
+
+        block = null_block;
     }
 }  // namespace memory
@@ -10,6 +10,7 @@
 
 // c++ includes
 #include <iterator>
+#include <vector>
 
 
 namespace memory::detail
@@ -21,11 +22,13 @@ namespace memory::detail
         T &m_instance;
 
     public:
-        auto static constexpr const node_size = sizeof(T::Node);
+        auto static constexpr const node_size = T::header_size;
 
+        /** Walks the free nodes of every slab with free nodes */
         class iterator
         {
         private:
+            T::Slab *m_slab;
             T::Node *m_current;
 
         public:
@@ -35,13 +38,13 @@ namespace memory::detail
             using pointer           = Block *;
             using reference         = Block &;
 
-            explicit iterator(T::Node *current);
+            explicit iterator(T::Slab *slab);
 
             auto inline operator==(iterator const &other) const noexcept -> bool;
             auto inline operator!=(iterator const &other) const noexcept -> bool;
 
             auto inline operator++() noexcept -> iterator &;
-            auto inline operator++(i32) const noexcept -> iterator;
+            auto inline operator++(int) noexcept -> iterator;
             auto inline operator*() const noexcept -> value_type;
         };
 
@@ -56,23 +59,83 @@ namespace memory::detail
 
 namespace memory
 {
-    template <class Allocator, usize BS, usize Min, usize Max, usize Cap>
-    class FreeList: public AllocatorInterface
+    /**
+     * Pool of fixed `Max` sized blocks for requests in `[Min, Max]`
+     *
+     * A miss carves a slab of up to `BS` nodes out of a single upstream
+     * allocation. Each slab keeps its own free nodes, linked through their
+     * payloads. Once every node of a slab is free again, the slab goes back
+     * upstream. The most recently emptied slab is kept as a spare to avoid
+     * thrashing at the boundary.
+     *
+     * Node headers hold the owning slab and sit in front of each payload.
+     * With `OutOfLine` there are no headers, payloads are packed back to back
+     * and the slab is found by a binary search over the slabs instead. Builds
+     * without `NDEBUG` run that search in-line too, ignoring foreign blocks
+     * instead of writing through a header they do not have.
+     *
+     * @tparam Allocator upstream of the slabs
+     * @tparam BS nodes per slab
+     * @tparam Min smallest request served
+     * @tparam Max largest request served, the size of every node
+     * @tparam Cap upper bound on the amount of nodes
+     * @tparam OutOfLine keep node headers out of the payload stride
+     */
+    template <class Allocator, usize BS, usize Min, usize Max, usize Cap, bool OutOfLine = false>
+    class FreeList: private NonCopyable
     {
     private:
-        using self = FreeList<Allocator, BS, Min, Max, Cap>;
+        using self = FreeList<Allocator, BS, Min, Max, Cap, OutOfLine>;
         friend detail::FreeListHelper<self>;
 
+        static_assert(Max >= sizeof(void *), "free nodes are linked through their payloads");
+
         struct Node
         {
-            Block block;
             Node *next;
         };
 
+        struct Slab
+        {
+            /** Upstream block holding the slab */
+            Block block;
+            /** Links of the list of slabs with free nodes */
+            Slab *prev;
+            Slab *next;
+            /** Free nodes of this slab */
+            Node *head;
+            /** Amount of nodes carved */
+            usize count;
+            /** Amount of free nodes */
+            usize free;
+        };
+
+        usize static constexpr const header_size { OutOfLine ? 0U : sizeof(Slab *) };
+        usize static constexpr const stride { header_size + align_size<WORD_ALIGN>(Max) };
+        usize static constexpr const slab_header { align_size<WORD_ALIGN>(sizeof(Slab)) };
+
         Allocator m_allocator {};
-        Node *m_head { nullptr };
+
+        /** Slabs with free nodes, most recently refilled first */
+        Slab *m_partial { nullptr };
+        /** Emptied slab kept back from upstream */
+        Slab *m_spare { nullptr };
+        /** Every slab, ordered by address */
+        std::vector<Slab *> m_slabs {};
+
         usize m_allocs { 0U };
 
+        auto static inline payload_of(Slab *slab, usize index) noexcept -> u8 *;
+
+        /** Slab whose payloads contain `addr`, `nullptr` for foreign addresses */
+        auto find_slab(void const *addr) const noexcept -> Slab *;
+        auto slab_of(Block const &block) const noexcept -> Slab *;
+        auto refill() -> bool;
+        auto release(Slab *slab) -> void;
+
+        auto inline link(Slab *slab) noexcept -> void;
+        auto inline unlink(Slab *slab) noexcept -> void;
+
     public:
         using allocator_type = Allocator;
 
@@ -80,9 +143,16 @@ namespace memory
         usize static constexpr const min { Min };
         usize static constexpr const max { Max };
         usize static constexpr const capacity { Cap };
+        bool static constexpr const out_of_line { OutOfLine };
+
+        FreeList() = default;
+        ~FreeList();
+
+        auto alloc(usize size) -> Block;
+        auto owns(Block &block) const noexcept -> bool;
+        auto free(Block &block) -> void;
 
-        auto alloc(usize size) -> Block override;
-        auto owns(Block &block) const noexcept -> bool override;
-        auto free(Block &block) -> void override;
+        /** Amount of slabs held, including the spare */
+        [[nodiscard]] auto slabs() const noexcept -> usize;
     };
 }  // namespace memory
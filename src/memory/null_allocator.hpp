@@ -11,11 +11,11 @@
 
 namespace memory
 {
-    class NullAllocator: public AllocatorInterface
+    class NullAllocator: private NonCopyable
     {
     public:
-        auto alloc(usize size = 0) -> Block override;
-        auto owns(Block &block) const noexcept -> bool override;
-        auto free(Block &block) -> void override;
+        auto alloc(usize size = 0) -> Block;
+        auto owns(Block &block) const noexcept -> bool;
+        auto free(Block &block) -> void;
     };
 }  // namespace memory
@@ -0,0 +1,239 @@
+/** @file object_pool.cpp */
+
+// module includes
+#include "object_pool.hpp"
+
+// c++ includes
+#include <memory>
+
+namespace memory
+{
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    ObjectPool<T, Allocator, SlabSize>::~ObjectPool()
+    {
+        this->clear();
+
+        for (auto &slab : m_slabs) {
+            m_allocator.free(slab);
+        }
+    }
+
+    // ============================================================================================== //
+    // Utility methods ============================================================================== //
+    // ============================================================================================== //
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto inline ObjectPool<T, Allocator, SlabSize>::at(usize position) noexcept -> T *
+    {
+        return (static_cast<T *>(m_slabs[position / SlabSize].addr) + (position % SlabSize));
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto inline ObjectPool<T, Allocator, SlabSize>::at(usize position) const noexcept -> T const *
+    {
+        return (static_cast<T const *>(m_slabs[position / SlabSize].addr) + (position % SlabSize));
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto ObjectPool<T, Allocator, SlabSize>::grow() -> bool
+    {
+        if (this->capacity() >= max_size) {
+            return (false);
+        }
+
+        auto slab = m_allocator.alloc(SlabSize * sizeof(T));
+        if (slab == null_block) {
+            return (false);
+        }
+
+        SCOPE_FAIL
+        {
+            m_allocator.free(slab);
+        };
+
+        m_slabs.push_back(slab);
+
+        return (true);
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto ObjectPool<T, Allocator, SlabSize>::acquire_slot() -> std::uint32_t
+    {
+        if (m_free != no_slot) {
+            auto slot = m_free;
+            m_free    = m_slots[slot].link;
+
+            return (slot);
+        }
+
+        if (m_slots.size() >= max_size) {
+            return (no_slot);
+        }
+
+        m_slots.push_back(Slot { 1U, 0U });
+
+        return (static_cast<std::uint32_t>(m_slots.size() - 1U));
+    }
+
+    // ============================================================================================== //
+    // ObjectPool implementation ==================================================================== //
+    // ============================================================================================== //
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    template <class... Args>
+    auto ObjectPool<T, Allocator, SlabSize>::create(Args &&...args) -> PoolHandle
+    {
+        if ((m_size == this->capacity()) && !this->grow()) {
+            return (null_handle);
+        }
+
+        auto slot = this->acquire_slot();
+        if (slot == no_slot) {
+            return (null_handle);
+        }
+
+        {
+            SCOPE_FAIL
+            {
+                m_slots[slot].link = m_free;
+                m_free             = slot;
+            };
+
+            m_owners.push_back(slot);
+            SCOPE_FAIL
+            {
+                m_owners.pop_back();
+            };
+
+            std::construct_at(this->at(m_size), std::forward<Args>(args)...);
+        }
+
+        m_slots[slot].link = static_cast<std::uint32_t>(m_size);
+        m_size += 1U;
+
+        return (PoolHandle { (m_slots[slot].generation << PoolHandle::index_bits) | slot });
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto ObjectPool<T, Allocator, SlabSize>::destroy(PoolHandle handle) -> bool
+    {
+        if (!this->valid(handle)) {
+            return (false);
+        }
+
+        auto slot     = handle.index();
+        auto position = static_cast<usize>(m_slots[slot].link);
+        auto last     = m_size - 1U;
+
+        std::destroy_at(this->at(position));
+
+        // keep the live range dense by moving the last object into the hole
+        if (position != last) {
+            std::construct_at(this->at(position), std::move(*this->at(last)));
+            std::destroy_at(this->at(last));
+
+            m_owners[position]                = m_owners[last];
+            m_slots[m_owners[position]].link = static_cast<std::uint32_t>(position);
+        }
+
+        m_owners.pop_back();
+        m_size -= 1U;
+
+        // slots whose generation would wrap are retired instead of reused
+        auto &entry      = m_slots[slot];
+        entry.generation = (entry.generation + 1U) & PoolHandle::generation_mask;
+
+        if (entry.generation != 0U) {
+            entry.link = m_free;
+            m_free     = slot;
+        }
+
+        return (true);
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto ObjectPool<T, Allocator, SlabSize>::clear() noexcept -> void
+    {
+        while (m_size > 0U) {
+            this->destroy(this->handle_at(m_size - 1U));
+        }
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto ObjectPool<T, Allocator, SlabSize>::valid(PoolHandle handle) const noexcept -> bool
+    {
+        auto slot = handle.index();
+
+        return ((handle.generation() != 0U) && (slot < m_slots.size())
+                && (m_slots[slot].generation == handle.generation()) && (m_slots[slot].link < m_size)
+                && (m_owners[m_slots[slot].link] == slot));
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto ObjectPool<T, Allocator, SlabSize>::get(PoolHandle handle) noexcept -> T *
+    {
+        if (!this->valid(handle)) {
+            return (nullptr);
+        }
+
+        return (this->at(m_slots[handle.index()].link));
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto ObjectPool<T, Allocator, SlabSize>::get(PoolHandle handle) const noexcept -> T const *
+    {
+        if (!this->valid(handle)) {
+            return (nullptr);
+        }
+
+        return (this->at(m_slots[handle.index()].link));
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto ObjectPool<T, Allocator, SlabSize>::handle_at(usize position) const noexcept -> PoolHandle
+    {
+        auto slot = m_owners[position];
+
+        return (PoolHandle { (m_slots[slot].generation << PoolHandle::index_bits) | slot });
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto ObjectPool<T, Allocator, SlabSize>::size() const noexcept -> usize
+    {
+        return (m_size);
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto ObjectPool<T, Allocator, SlabSize>::capacity() const noexcept -> usize
+    {
+        return (m_slabs.size() * SlabSize);
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto ObjectPool<T, Allocator, SlabSize>::begin() noexcept -> iterator
+    {
+        return (iterator { this, 0U });
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto ObjectPool<T, Allocator, SlabSize>::end() noexcept -> iterator
+    {
+        return (iterator { this, m_size });
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto ObjectPool<T, Allocator, SlabSize>::begin() const noexcept -> const_iterator
+    {
+        return (const_iterator { this, 0U });
+    }
+
+    template <class T, IsAllocator Allocator, usize SlabSize>
+    auto ObjectPool<T, Allocator, SlabSize>::end() const noexcept -> const_iterator
+    {
+        return (const_iterator { this, m_size });
+    }
+}  // namespace memory
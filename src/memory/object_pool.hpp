@@ -0,0 +1,208 @@
+/** @file object_pool.hpp */
+
+#pragma once
+
+// module includes
+#include "allocator_interface.hpp"
+#include "block.hpp"
+#include "util/util.hpp"
+#include "utils.hpp"
+
+// c++ includes
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+
+namespace memory
+{
+    /**
+     * Generational reference to an object of an `ObjectPool`
+     *
+     * The low `index_bits` select a slot, the rest is the generation the slot
+     * had when the object was created. Destroying the object bumps the
+     * generation, so stale handles no longer match.
+     */
+    struct PoolHandle
+    {
+        std::uint32_t static constexpr const index_bits { 20U };
+        std::uint32_t static constexpr const index_mask { (std::uint32_t { 1U } << index_bits) - 1U };
+        std::uint32_t static constexpr const generation_mask { ~std::uint32_t { 0U } >> index_bits };
+
+        /** Generation `0` is never handed out, so the zero handle is null */
+        std::uint32_t value;
+
+        [[nodiscard]] auto inline constexpr index() const noexcept -> std::uint32_t
+        {
+            return (value & index_mask);
+        }
+
+        [[nodiscard]] auto inline constexpr generation() const noexcept -> std::uint32_t
+        {
+            return (value >> index_bits);
+        }
+
+        auto inline constexpr operator==(PoolHandle const &other) const noexcept -> bool = default;
+
+        explicit inline constexpr operator bool() const noexcept
+        {
+            return (value != 0U);
+        }
+    };
+
+    /** Handle never referring to an object */
+    PoolHandle static constexpr const null_handle = { 0U };
+
+    /**
+     * Pool of `T` packed densely in slabs, referenced by `PoolHandle`
+     *
+     * Live objects occupy the first `size()` positions, so iteration touches
+     * contiguous memory only. Destroying an object moves the last one into
+     * its place, pointers are therefore only stable until the next `destroy`.
+     * Handles stay valid, a slot table maps them to positions in O(1).
+     *
+     * Slabs of `SlabSize` objects are drawn from `Allocator` when the pool
+     * fills up and kept until the pool is destroyed. `Allocator` has to align
+     * blocks to at least `alignof(T)`.
+     *
+     * @tparam T pooled type, has to be nothrow move constructible
+     * @tparam Allocator upstream of the slabs
+     * @tparam SlabSize objects per slab, a power of two
+     */
+    template <class T, IsAllocator Allocator, usize SlabSize = 64U>
+    class ObjectPool: private NonCopyable
+    {
+    private:
+        using self = ObjectPool<T, Allocator, SlabSize>;
+
+        static_assert((SlabSize & (SlabSize - 1U)) == 0U, "slab size has to be a power of two");
+        static_assert(std::is_nothrow_move_constructible_v<T>, "pooled objects are relocated on destroy");
+
+        struct Slot
+        {
+            /** Current generation, `0` once the slot is retired */
+            std::uint32_t generation;
+            /** Position of the object while live, next free slot otherwise */
+            std::uint32_t link;
+        };
+
+        std::uint32_t static constexpr const no_slot { ~std::uint32_t { 0U } };
+
+        Allocator m_allocator {};
+        std::vector<Block> m_slabs {};
+
+        std::vector<Slot> m_slots {};
+        /** Slot of every live position */
+        std::vector<std::uint32_t> m_owners {};
+
+        std::uint32_t m_free { no_slot };
+        usize m_size { 0U };
+
+        auto inline at(usize position) noexcept -> T *;
+        auto inline at(usize position) const noexcept -> T const *;
+
+        auto grow() -> bool;
+        auto acquire_slot() -> std::uint32_t;
+
+    public:
+        template <class Pointer, class Reference>
+        class basic_iterator
+        {
+        private:
+            using pool_type = std::conditional_t<std::is_const_v<std::remove_reference_t<Reference>>, self const, self>;
+
+            pool_type *m_pool;
+            usize m_position;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = T;
+            using difference_type   = isize;
+            using pointer           = Pointer;
+            using reference         = Reference;
+
+            basic_iterator(pool_type *pool, usize position): m_pool { pool }, m_position { position }
+            {
+            }
+
+            auto inline operator==(basic_iterator const &other) const noexcept -> bool
+            {
+                return (m_position == other.m_position);
+            }
+
+            auto inline operator++() noexcept -> basic_iterator &
+            {
+                m_position += 1U;
+                return (*this);
+            }
+
+            auto inline operator++(int) noexcept -> basic_iterator
+            {
+                auto previous = *this;
+                m_position += 1U;
+
+                return (previous);
+            }
+
+            auto inline operator*() const noexcept -> reference
+            {
+                return (*m_pool->at(m_position));
+            }
+
+            auto inline operator->() const noexcept -> pointer
+            {
+                return (m_pool->at(m_position));
+            }
+        };
+
+        using iterator       = basic_iterator<T *, T &>;
+        using const_iterator = basic_iterator<T const *, T const &>;
+
+        usize static constexpr const slab_size { SlabSize };
+        usize static constexpr const max_size { usize { PoolHandle::index_mask } + 1U };
+
+        ObjectPool() = default;
+        ~ObjectPool();
+
+        /**
+         * Constructs an object in place
+         *
+         * @param args arguments forwarded to the constructor of `T`
+         * @return handle to the object, `null_handle` if the pool is exhausted
+         */
+        template <class... Args>
+        auto create(Args &&...args) -> PoolHandle;
+
+        /**
+         * Destroys the object referenced by `handle`
+         *
+         * @return whether `handle` was live
+         */
+        auto destroy(PoolHandle handle) -> bool;
+
+        /** Destroys every object, slabs are kept */
+        auto clear() noexcept -> void;
+
+        /** Checks whether `handle` refers to a live object */
+        [[nodiscard]] auto valid(PoolHandle handle) const noexcept -> bool;
+
+        /** Resolves `handle`, `nullptr` if stale */
+        [[nodiscard]] auto get(PoolHandle handle) noexcept -> T *;
+        [[nodiscard]] auto get(PoolHandle handle) const noexcept -> T const *;
+
+        /** Handle of the object at `position` of the dense range */
+        [[nodiscard]] auto handle_at(usize position) const noexcept -> PoolHandle;
+
+        /** Amount of live objects */
+        [[nodiscard]] auto size() const noexcept -> usize;
+
+        /** Amount of objects the current slabs hold */
+        [[nodiscard]] auto capacity() const noexcept -> usize;
+
+        [[nodiscard]] auto begin() noexcept -> iterator;
+        [[nodiscard]] auto end() noexcept -> iterator;
+        [[nodiscard]] auto begin() const noexcept -> const_iterator;
+        [[nodiscard]] auto end() const noexcept -> const_iterator;
+    };
+}  // namespace memory
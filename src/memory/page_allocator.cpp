@@ -0,0 +1,248 @@
+/** @file page_allocator.cpp */
+
+// module includes
+#include "page_allocator.hpp"
+
+// c++ includes
+#include <new>
+
+// platform includes
+// clang-format off
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+// clang-format on
+
+namespace memory::detail
+{
+    // ============================================================================================== //
+    // Platform layer =============================================================================== //
+    // ============================================================================================== //
+
+    auto page_size() noexcept -> usize
+    {
+#if defined(_WIN32)
+        usize static const size = [] {
+            SYSTEM_INFO info {};
+            GetSystemInfo(&info);
+
+            return (static_cast<usize>(info.dwPageSize));
+        }();
+#else
+        usize static const size = static_cast<usize>(sysconf(_SC_PAGESIZE));
+#endif
+
+        return (size);
+    }
+
+    auto page_round(usize size, PageHint hint) noexcept -> usize
+    {
+        auto granularity = (hint == PageHint::Huge) ? HUGE_PAGE_SIZE : page_size();
+
+        return ((size + granularity - 1U) & ~(granularity - 1U));
+    }
+
+#if defined(_WIN32)
+    // large pages require `SeLockMemoryPrivilege`, hints are ignored on windows
+
+    auto map_pages(usize size, PageHint /*hint*/, bool commit) noexcept -> void *
+    {
+        auto type    = commit ? (MEM_RESERVE | MEM_COMMIT) : MEM_RESERVE;
+        auto protect = commit ? PAGE_READWRITE : PAGE_NOACCESS;
+
+        return (VirtualAlloc(nullptr, size, type, protect));
+    }
+
+    auto unmap_pages(void *addr, usize /*size*/) noexcept -> void
+    {
+        VirtualFree(addr, 0U, MEM_RELEASE);
+    }
+
+    auto commit_pages(void *addr, usize size, PageHint /*hint*/) noexcept -> bool
+    {
+        return (VirtualAlloc(addr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr);
+    }
+
+    auto decommit_pages(void *addr, usize size) noexcept -> void
+    {
+        VirtualFree(addr, size, MEM_DECOMMIT);
+    }
+#else
+    /** Advises the kernel to back a range with transparent huge pages */
+    auto static advise_huge(void *addr, usize size, PageHint hint) noexcept -> void
+    {
+#if defined(MADV_HUGEPAGE)
+        if (hint != PageHint::None) {
+            madvise(addr, size, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    auto map_pages(usize size, PageHint hint, bool commit) noexcept -> void *
+    {
+        auto protect = commit ? (PROT_READ | PROT_WRITE) : PROT_NONE;
+        auto flags   = commit ? (MAP_PRIVATE | MAP_ANONYMOUS) : (MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE);
+
+#if defined(MAP_HUGETLB)
+        if (commit && (hint == PageHint::Huge)) {
+            auto *addr = mmap(nullptr, size, protect, flags | MAP_HUGETLB, -1, 0);
+            if (addr != MAP_FAILED) {
+                return (addr);
+            }
+        }
+#endif
+
+        auto *addr = mmap(nullptr, size, protect, flags, -1, 0);
+        if (addr == MAP_FAILED) {
+            return (nullptr);
+        }
+
+        advise_huge(addr, size, hint);
+
+        return (addr);
+    }
+
+    auto unmap_pages(void *addr, usize size) noexcept -> void
+    {
+        munmap(addr, size);
+    }
+
+    auto commit_pages(void *addr, usize size, PageHint hint) noexcept -> bool
+    {
+        if (mprotect(addr, size, PROT_READ | PROT_WRITE) != 0) {
+            return (false);
+        }
+
+        advise_huge(addr, size, hint);
+
+        return (true);
+    }
+
+    auto decommit_pages(void *addr, usize size) noexcept -> void
+    {
+        madvise(addr, size, MADV_DONTNEED);
+        mprotect(addr, size, PROT_NONE);
+    }
+#endif
+}  // namespace memory::detail
+
+namespace memory
+{
+    // ============================================================================================== //
+    // Utility methods ============================================================================== //
+    // ============================================================================================== //
+
+    template <PageHint hint>
+    auto PageAllocator<hint>::track(void *addr, usize size) -> Block
+    {
+        Block block { addr, size };
+
+        try {
+            std::lock_guard<std::mutex> lock { m_lock };
+            m_pages.insert(block, mapped);
+        } catch (std::bad_alloc const &) {
+            detail::unmap_pages(addr, size);
+            return (null_block);
+        }
+
+        return (block);
+    }
+
+    // ============================================================================================== //
+    // Reserve and commit =========================================================================== //
+    // ============================================================================================== //
+
+    template <PageHint hint>
+    auto PageAllocator<hint>::reserve(usize size) -> Block
+    {
+        if (size == 0U) {
+            return (null_block);
+        }
+
+        auto rounded = detail::page_round(size, hint);
+        auto *addr   = detail::map_pages(rounded, hint, false);
+
+        if (addr == nullptr) {
+            return (null_block);
+        }
+
+        return (this->track(addr, rounded));
+    }
+
+    template <PageHint hint>
+    auto PageAllocator<hint>::commit(Block const &range) -> bool
+    {
+        auto rounded = detail::page_round(range.size, PageHint::None);
+
+        return (detail::commit_pages(range.addr, rounded, hint));
+    }
+
+    template <PageHint hint>
+    auto PageAllocator<hint>::decommit(Block const &range) -> void
+    {
+        auto rounded = detail::page_round(range.size, PageHint::None);
+
+        detail::decommit_pages(range.addr, rounded);
+    }
+
+    // ============================================================================================== //
+    // PageAllocator implementation ================================================================= //
+    // ============================================================================================== //
+
+    template <PageHint hint>
+    auto PageAllocator<hint>::alloc(usize size) -> Block
+    {
+        if (size == 0U) {
+            return (null_block);
+        }
+
+        auto rounded = detail::page_round(size, hint);
+        auto *addr   = detail::map_pages(rounded, hint, true);
+
+        if (addr == nullptr) {
+            return (null_block);
+        }
+
+        return (this->track(addr, rounded));
+    }
+
+    template <PageHint hint>
+    auto PageAllocator<hint>::owns(Block &block) const noexcept -> bool
+    {
+        if (block.addr == nullptr) {
+            return (false);
+        }
+
+        std::lock_guard<std::mutex> lock { m_lock };
+        return (m_pages.find(block) == mapped);
+    }
+
+    template <PageHint hint>
+    auto PageAllocator<hint>::free(Block &block) -> void
+    {
+        if (block.addr == nullptr) {
+            return;
+        }
+
+        auto rounded = detail::page_round(block.size, hint);
+        {
+            std::lock_guard<std::mutex> lock { m_lock };
+            m_pages.erase(Block { block.addr, rounded });
+        }
+
+        detail::unmap_pages(block.addr, rounded);
+
+        block = null_block;
+    }
+
+    template class PageAllocator<PageHint::None>;
+    template class PageAllocator<PageHint::Transparent>;
+    template class PageAllocator<PageHint::Huge>;
+}  // namespace memory
@@ -0,0 +1,115 @@
+/** @file page_allocator.hpp */
+
+#pragma once
+
+// module includes
+#include "allocator_interface.hpp"
+#include "block.hpp"
+#include "page_map.hpp"
+#include "util/util.hpp"
+#include "utils.hpp"
+
+// c++ includes
+#include <mutex>
+
+
+namespace memory
+{
+    /** Size of a huge page, as used by `PageHint::Huge` */
+    usize static constexpr const HUGE_PAGE_SIZE = { 2U * 1024U * 1024U };
+
+    /** Hints on how the OS should back the mapped pages */
+    enum class PageHint
+    {
+        /** Regular pages */
+        None,
+        /** Regular mapping, advised to be backed by transparent huge pages */
+        Transparent,
+        /** Explicit huge pages, falls back to `Transparent` if none are available */
+        Huge,
+    };
+
+    namespace detail
+    {
+        /** Size of a regular OS page */
+        auto page_size() noexcept -> usize;
+
+        /** Rounds `size` up to the granularity used by `hint` */
+        auto page_round(usize size, PageHint hint) noexcept -> usize;
+
+        /** Maps `size` bytes, committed or merely reserved */
+        auto map_pages(usize size, PageHint hint, bool commit) noexcept -> void *;
+
+        /** Unmaps a range acquired by `map_pages` */
+        auto unmap_pages(void *addr, usize size) noexcept -> void;
+
+        /** Makes a reserved range accessible */
+        auto commit_pages(void *addr, usize size, PageHint hint) noexcept -> bool;
+
+        /** Gives the physical pages of a range back to the OS, keeping it reserved */
+        auto decommit_pages(void *addr, usize size) noexcept -> void;
+    }  // namespace detail
+
+    /**
+     * Leaf allocator acquiring memory straight from the OS
+     *
+     * Every allocation is a separate mapping rounded up to the page size (or
+     * `HUGE_PAGE_SIZE` with `PageHint::Huge`). Large virtual ranges can be
+     * reserved up-front and committed piecewise as they get used.
+     *
+     * Live mappings are recorded in a `PageMap`, so `owns()` only claims
+     * blocks it handed out and the allocator can sit on either side of a
+     * composite. The map is guarded, the allocator stays thread safe.
+     *
+     * @tparam hint how the OS should back the mapped pages
+     */
+    template <PageHint hint = PageHint::None>
+    class PageAllocator: private NonCopyable
+    {
+    private:
+        /** Owner index of every live mapping in `m_pages` */
+        usize static constexpr const mapped { 0U };
+
+        PageMap m_pages {};
+        mutable std::mutex m_lock {};
+
+        /** Records a fresh mapping, unmapping it if that fails */
+        auto track(void *addr, usize size) -> Block;
+
+    public:
+        PageHint static constexpr const page_hint { hint };
+
+        /**
+         * Reserves address space without backing it with memory
+         *
+         * @param size size of the range, rounded up to the page size
+         * @return reserved range or `null_block`
+         */
+        auto reserve(usize size) -> Block;
+
+        /**
+         * Backs a page-aligned part of a reserved range with memory
+         *
+         * @param range range to commit
+         * @return `true` if the range is now accessible
+         */
+        auto commit(Block const &range) -> bool;
+
+        /**
+         * Releases the physical memory of a page-aligned range
+         *
+         * The range stays reserved and has to be committed again before use.
+         *
+         * @param range range to decommit
+         */
+        auto decommit(Block const &range) -> void;
+
+        auto alloc(usize size) -> Block;
+        auto owns(Block &block) const noexcept -> bool;
+        auto free(Block &block) -> void;
+    };
+
+    extern template class PageAllocator<PageHint::None>;
+    extern template class PageAllocator<PageHint::Transparent>;
+    extern template class PageAllocator<PageHint::Huge>;
+}  // namespace memory
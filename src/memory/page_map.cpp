@@ -0,0 +1,143 @@
+/** @file page_map.cpp */
+
+// module includes
+#include "page_map.hpp"
+
+namespace memory
+{
+    // ============================================================================================== //
+    // Utility methods ============================================================================== //
+    // ============================================================================================== //
+
+    auto PageMap::entry(uintptr page) const noexcept -> Entry *
+    {
+        if (!m_root) {
+            return (nullptr);
+        }
+
+        auto const &mid = (*m_root)[(page >> (level_bits * 2U)) & level_mask];
+        if (!mid) {
+            return (nullptr);
+        }
+
+        auto const &leaf = (*mid)[(page >> level_bits) & level_mask];
+        if (!leaf) {
+            return (nullptr);
+        }
+
+        return (&(*leaf)[page & level_mask]);
+    }
+
+    auto PageMap::make_entry(uintptr page) -> Entry *
+    {
+        if (!m_root) {
+            m_root = CreateScope<Root>();
+        }
+
+        auto &mid = (*m_root)[(page >> (level_bits * 2U)) & level_mask];
+        if (!mid) {
+            mid = CreateScope<Mid>();
+        }
+
+        auto &leaf = (*mid)[(page >> level_bits) & level_mask];
+        if (!leaf) {
+            leaf = CreateScope<Leaf>();
+            leaf->fill(Entry { static_cast<std::uint16_t>(none), 0U });
+        }
+
+        return (&(*leaf)[page & level_mask]);
+    }
+
+    auto PageMap::retain(uintptr page, usize owner) -> void
+    {
+        auto *current = this->make_entry(page);
+
+        if (current->count == 0U) {
+            current->owner = static_cast<std::uint16_t>(owner);
+        } else if (current->owner != owner) {
+            current->owner = static_cast<std::uint16_t>(ambiguous);
+        }
+
+        current->count += 1U;
+    }
+
+    auto PageMap::release(uintptr page) noexcept -> void
+    {
+        auto *current = this->entry(page);
+        if ((current == nullptr) || (current->count == 0U)) {
+            return;
+        }
+
+        current->count -= 1U;
+        if (current->count == 0U) {
+            current->owner = static_cast<std::uint16_t>(none);
+        }
+    }
+
+    auto PageMap::indexable(Block const &block) noexcept -> bool
+    {
+        auto addr = reinterpret_cast<uintptr>(block.addr);
+
+        return ((block.addr != nullptr) && (block.size > 0U) && (((addr + block.size) >> address_bits) == 0U));
+    }
+
+    // ============================================================================================== //
+    // PageMap implementation ======================================================================= //
+    // ============================================================================================== //
+
+    auto PageMap::insert(Block const &block, usize owner) -> void
+    {
+        if (!PageMap::indexable(block)) {
+            return;
+        }
+
+        auto first = reinterpret_cast<uintptr>(block.addr) >> page_bits;
+        auto last  = (reinterpret_cast<uintptr>(block.addr) + block.size - 1U) >> page_bits;
+
+        this->retain(first, owner);
+        if (last == first) {
+            return;
+        }
+
+        SCOPE_FAIL
+        {
+            this->release(first);
+        };
+
+        this->retain(last, owner);
+    }
+
+    auto PageMap::erase(Block const &block) noexcept -> void
+    {
+        if (!PageMap::indexable(block)) {
+            return;
+        }
+
+        auto first = reinterpret_cast<uintptr>(block.addr) >> page_bits;
+        auto last  = (reinterpret_cast<uintptr>(block.addr) + block.size - 1U) >> page_bits;
+
+        this->release(first);
+        if (last != first) {
+            this->release(last);
+        }
+    }
+
+    auto PageMap::find(Block const &block) const noexcept -> usize
+    {
+        if (!PageMap::indexable(block)) {
+            return (ambiguous);
+        }
+
+        auto const *current = this->entry(reinterpret_cast<uintptr>(block.addr) >> page_bits);
+        if ((current == nullptr) || (current->count == 0U)) {
+            return (none);
+        }
+
+        return (current->owner);
+    }
+
+    auto PageMap::clear() noexcept -> void
+    {
+        m_root.reset();
+    }
+}  // namespace memory
@@ -0,0 +1,104 @@
+/** @file page_map.hpp */
+
+#pragma once
+
+// module includes
+#include "block.hpp"
+#include "util/util.hpp"
+#include "utils.hpp"
+
+// c++ includes
+#include <array>
+#include <cstdint>
+
+
+namespace memory
+{
+    /**
+     * Radix tree mapping page numbers to the allocator owning them
+     *
+     * Used by composite allocators to route `owns()` and `free()` to a child
+     * in constant time. Pages are reference counted per live block; a page
+     * holding blocks of several owners is reported as `ambiguous` and the
+     * caller has to fall back to asking each child.
+     *
+     * A page without registered blocks proves a block is foreign. Anything else
+     * only names the single child worth asking, as other allocators may have
+     * handed out blocks on the same page.
+     *
+     * Only the first and last page of a block are registered, so inserting
+     * and erasing cost the same whatever the block size. Live blocks do not
+     * overlap, no other block can start on the pages in between: lookups
+     * by the start of a live block are exact, interior addresses are not
+     * resolved.
+     *
+     * Covers 48-bit addresses with 4 KiB pages in three 12-bit levels,
+     * interior levels are allocated on first use.
+     */
+    class PageMap: private NonCopyable
+    {
+    private:
+        usize static constexpr const page_bits { 12U };
+        usize static constexpr const level_bits { 12U };
+        usize static constexpr const level_size { usize { 1U } << level_bits };
+        usize static constexpr const level_mask { level_size - 1U };
+        usize static constexpr const address_bits { page_bits + (level_bits * 3U) };
+
+        /** Owner and amount of live blocks touching a page */
+        struct Entry
+        {
+            std::uint16_t owner;
+            std::uint16_t count;
+        };
+
+        using Leaf = std::array<Entry, level_size>;
+        using Mid  = std::array<Scope<Leaf>, level_size>;
+        using Root = std::array<Scope<Mid>, level_size>;
+
+        Scope<Root> m_root {};
+
+        auto entry(uintptr page) const noexcept -> Entry *;
+        auto make_entry(uintptr page) -> Entry *;
+
+        auto retain(uintptr page, usize owner) -> void;
+        auto release(uintptr page) noexcept -> void;
+
+        auto static indexable(Block const &block) noexcept -> bool;
+
+    public:
+        /** No live block is registered on the page */
+        usize static constexpr const none { 0xFFFFU };
+
+        /** Live blocks of different owners share the page, or the block cannot be indexed */
+        usize static constexpr const ambiguous { 0xFFFEU };
+
+        PageMap()  = default;
+        ~PageMap() = default;
+
+        /**
+         * Registers the first and last page of `block` with `owner`
+         *
+         * @param block freshly allocated block
+         * @param owner owner index, less than `ambiguous`
+         */
+        auto insert(Block const &block, usize owner) -> void;
+
+        /**
+         * Unregisters a block previously passed to `insert`
+         *
+         * @param block block about to be freed
+         */
+        auto erase(Block const &block) noexcept -> void;
+
+        /**
+         * Finds the owner of a live block
+         *
+         * @param block block to look up, by its start address
+         * @return owner index, `none`, or `ambiguous` if the block cannot be indexed
+         */
+        [[nodiscard]] auto find(Block const &block) const noexcept -> usize;
+
+        /** Drops every registration */
+        auto clear() noexcept -> void;
+    };
+}  // namespace memory
@@ -0,0 +1,43 @@
+/** @file polymorphic_allocator.cpp */
+
+// module includes
+#include "polymorphic_allocator.hpp"
+
+namespace memory
+{
+    template <IsAllocator Allocator>
+    auto PolymorphicAllocator<Allocator>::alloc(usize size) -> Block
+    {
+        return (m_allocator.alloc(size));
+    }
+
+    template <IsAllocator Allocator>
+    auto PolymorphicAllocator<Allocator>::owns(Block &block) const noexcept -> bool
+    {
+        return (m_allocator.owns(block));
+    }
+
+    template <IsAllocator Allocator>
+    auto PolymorphicAllocator<Allocator>::free(Block &block) -> void
+    {
+        m_allocator.free(block);
+    }
+
+    template <IsAllocator Allocator>
+    auto PolymorphicAllocator<Allocator>::expand(Block &block, usize delta) -> bool
+    {
+        return (memory::expand(m_allocator, block, delta));
+    }
+
+    template <IsAllocator Allocator>
+    auto PolymorphicAllocator<Allocator>::reallocate(Block &block, usize new_size) -> bool
+    {
+        return (memory::reallocate(m_allocator, block, new_size));
+    }
+
+    template <IsAllocator Allocator>
+    auto inline PolymorphicAllocator<Allocator>::get_allocator() noexcept -> Allocator &
+    {
+        return (m_allocator);
+    }
+}  // namespace memory
@@ -0,0 +1,40 @@
+/** @file polymorphic_allocator.hpp */
+
+#pragma once
+
+// module includes
+#include "allocator_interface.hpp"
+#include "block.hpp"
+#include "util/util.hpp"
+#include "utils.hpp"
+
+
+namespace memory
+{
+    /**
+     * Type-erases a statically composed allocator behind `AllocatorInterface`
+     *
+     * Calls into the wrapped allocator are direct, so a composite is inlined
+     * as a whole and only the outermost call dispatches virtually.
+     *
+     * @tparam Allocator wrapped allocator
+     */
+    template <IsAllocator Allocator>
+    class PolymorphicAllocator final: public AllocatorInterface
+    {
+    private:
+        Allocator m_allocator {};
+
+    public:
+        using allocator_type = Allocator;
+
+        auto alloc(usize size) -> Block override;
+        auto owns(Block &block) const noexcept -> bool override;
+        auto free(Block &block) -> void override;
+        auto expand(Block &block, usize delta) -> bool override;
+        auto reallocate(Block &block, usize new_size) -> bool override;
+
+        /** Provides access to the wrapped allocator */
+        auto inline get_allocator() noexcept -> Allocator &;
+    };
+}  // namespace memory
@@ -0,0 +1,200 @@
+/** @file region_allocator.cpp */
+
+// module includes
+#include "region_allocator.hpp"
+
+namespace memory
+{
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    template <class Allocator, usize ChunkSize, usize align>
+    RegionAllocator<Allocator, ChunkSize, align>::~RegionAllocator()
+    {
+        this->release();
+    }
+
+    // ============================================================================================== //
+    // Utility methods ============================================================================== //
+    // ============================================================================================== //
+
+    template <class Allocator, usize ChunkSize, usize align>
+    auto inline RegionAllocator<Allocator, ChunkSize, align>::data_of(Chunk *chunk) noexcept -> u8 *
+    {
+        return (align_front<align>(reinterpret_cast<u8 *>(chunk) + sizeof(Chunk)));
+    }
+
+    template <class Allocator, usize ChunkSize, usize align>
+    auto inline RegionAllocator<Allocator, ChunkSize, align>::end_of(Chunk *chunk) noexcept -> u8 *
+    {
+        return (static_cast<u8 *>(chunk->block) + chunk->block.size);
+    }
+
+    template <class Allocator, usize ChunkSize, usize align>
+    auto RegionAllocator<Allocator, ChunkSize, align>::grow(usize size) -> bool
+    {
+        auto overhead = sizeof(Chunk) + align;
+        auto block    = m_allocator.alloc(std::max(ChunkSize, size + overhead));
+
+        if (block == null_block) {
+            return (false);
+        }
+
+        auto *chunk  = reinterpret_cast<Chunk *>(block.addr);
+        chunk->block = block;
+        chunk->prev  = m_chunk;
+
+        m_chunk = chunk;
+        m_ptr   = self::data_of(chunk);
+        m_end   = self::end_of(chunk);
+
+        m_chunks += 1U;
+
+        return (true);
+    }
+
+    template <class Allocator, usize ChunkSize, usize align>
+    auto RegionAllocator<Allocator, ChunkSize, align>::pop_chunk() -> void
+    {
+        auto *chunk = m_chunk;
+        auto block  = chunk->block;
+
+        m_chunk = chunk->prev;
+        m_ptr   = (m_chunk != nullptr) ? self::end_of(m_chunk) : nullptr;
+        m_end   = m_ptr;
+
+        m_chunks -= 1U;
+
+        m_allocator.free(block);
+    }
+
+    template <class Allocator, usize ChunkSize, usize align>
+    auto RegionAllocator<Allocator, ChunkSize, align>::mark() const noexcept -> Marker
+    {
+        return (Marker { m_chunk, m_ptr });
+    }
+
+    template <class Allocator, usize ChunkSize, usize align>
+    auto RegionAllocator<Allocator, ChunkSize, align>::rewind(Marker const &marker) -> void
+    {
+        while ((m_chunk != nullptr) && (m_chunk != marker.chunk)) {
+            this->pop_chunk();
+        }
+
+        if (m_chunk != nullptr) {
+            m_ptr = marker.ptr;
+            m_end = self::end_of(m_chunk);
+        }
+    }
+
+    template <class Allocator, usize ChunkSize, usize align>
+    auto RegionAllocator<Allocator, ChunkSize, align>::release() -> void
+    {
+        while (m_chunk != nullptr) {
+            this->pop_chunk();
+        }
+    }
+
+    template <class Allocator, usize ChunkSize, usize align>
+    auto RegionAllocator<Allocator, ChunkSize, align>::chunks() const noexcept -> usize
+    {
+        return (m_chunks);
+    }
+
+    // ============================================================================================== //
+    // RegionAllocator implementation =============================================================== //
+    // ============================================================================================== //
+
+    template <class Allocator, usize ChunkSize, usize align>
+    auto RegionAllocator<Allocator, ChunkSize, align>::alloc(usize size) -> Block
+    {
+        if (size == 0U) {
+            return (null_block);
+        }
+
+        auto aligned = align_size<align>(size);
+        if ((m_ptr == nullptr) || (aligned > static_cast<usize>(m_end - m_ptr))) {
+            if (!this->grow(aligned)) {
+                return (null_block);
+            }
+        }
+
+        Block block { m_ptr, size };
+        m_ptr += aligned;
+
+        return (block);
+    }
+
+    template <class Allocator, usize ChunkSize, usize align>
+    auto RegionAllocator<Allocator, ChunkSize, align>::owns(Block &block) const noexcept -> bool
+    {
+        auto *addr = static_cast<u8 *>(block);
+
+        for (auto *chunk = m_chunk; chunk != nullptr; chunk = chunk->prev) {
+            if ((self::data_of(chunk) <= addr) && (addr < self::end_of(chunk))) {
+                return (true);
+            }
+        }
+
+        return (false);
+    }
+
+    template <class Allocator, usize ChunkSize, usize align>
+    auto RegionAllocator<Allocator, ChunkSize, align>::free(Block &block) -> void
+    {
+        // only the topmost block can be given back, the rest goes with the region
+        auto *addr = static_cast<u8 *>(block);
+
+        if ((m_chunk == nullptr) || (addr < self::data_of(m_chunk))) {
+            return;
+        }
+
+        if ((addr + align_size<align>(block.size)) == m_ptr) {
+            m_ptr = addr;
+            block = null_block;
+        }
+    }
+
+    template <class Allocator, usize ChunkSize, usize align>
+    auto RegionAllocator<Allocator, ChunkSize, align>::expand(Block &block, usize delta) -> bool
+    {
+        auto *addr = static_cast<u8 *>(block);
+
+        // only the topmost block of the current chunk borders free space
+        if ((m_chunk == nullptr) || (addr < self::data_of(m_chunk))
+            || ((addr + align_size<align>(block.size)) != m_ptr)) {
+            return (false);
+        }
+
+        if (delta > static_cast<usize>(m_end - addr) - block.size) {
+            return (false);
+        }
+
+        auto aligned = align_size<align>(block.size + delta);
+        if (aligned > static_cast<usize>(m_end - addr)) {
+            return (false);
+        }
+
+        m_ptr = addr + aligned;
+        block.size += delta;
+
+        return (true);
+    }
+
+    template <class Allocator, usize ChunkSize, usize align>
+    auto RegionAllocator<Allocator, ChunkSize, align>::reallocate(Block &block, usize new_size) -> bool
+    {
+        auto *addr = static_cast<u8 *>(block);
+
+        if ((m_chunk != nullptr) && (addr >= self::data_of(m_chunk)) && (new_size != 0U)
+            && (new_size < block.size) && ((addr + align_size<align>(block.size)) == m_ptr)) {
+            m_ptr      = addr + align_size<align>(new_size);
+            block.size = new_size;
+
+            return (true);
+        }
+
+        return (memory::reallocate_by_copy(*this, block, new_size));
+    }
+}  // namespace memory
@@ -0,0 +1,98 @@
+/** @file region_allocator.hpp */
+
+#pragma once
+
+// module includes
+#include "allocator_interface.hpp"
+#include "block.hpp"
+#include "util/util.hpp"
+#include "utils.hpp"
+
+// c++ includes
+#include <algorithm>
+
+
+namespace memory
+{
+    /**
+     * Growable linear allocator backed by chunks from an upstream allocator
+     *
+     * Allocations bump a pointer through the newest chunk. On overflow a new
+     * chunk of at least `ChunkSize` bytes is requested and chained in front of
+     * the previous ones. Everything is given back at once with `release()`,
+     * or down to a previously taken `Marker` with `rewind()`.
+     *
+     * @tparam Allocator upstream allocator the chunks are taken from
+     * @tparam ChunkSize minimum size of each chunk in bytes
+     * @tparam align alignment of every allocation
+     */
+    template <class Allocator, usize ChunkSize, usize align = WORD_ALIGN>
+    class RegionAllocator: private NonCopyable
+    {
+    private:
+        using self = RegionAllocator<Allocator, ChunkSize, align>;
+
+        static_assert(is_power_of_two(align), "alignment must be power of two");
+
+        /** Header stored at the front of each chunk */
+        struct Chunk
+        {
+            Block block;
+            Chunk *prev;
+        };
+
+        Allocator m_allocator {};
+
+        Chunk *m_chunk { nullptr };
+        u8 *m_ptr { nullptr };
+        u8 *m_end { nullptr };
+
+        usize m_chunks { 0U };
+
+        auto static inline data_of(Chunk *chunk) noexcept -> u8 *;
+        auto static inline end_of(Chunk *chunk) noexcept -> u8 *;
+
+        auto grow(usize size) -> bool;
+        auto pop_chunk() -> void;
+
+    public:
+        /** Position in the region that can be rewound to */
+        struct Marker
+        {
+            void *chunk;
+            u8 *ptr;
+        };
+
+        using allocator_type = Allocator;
+
+        usize static constexpr const chunk_size { ChunkSize };
+        usize static constexpr const alignment { align };
+
+        RegionAllocator() = default;
+        ~RegionAllocator();
+
+        /** Captures the current position of the region */
+        [[nodiscard]] auto mark() const noexcept -> Marker;
+
+        /**
+         * Frees everything allocated after `marker` was taken
+         *
+         * Chunks chained after the marker are returned upstream.
+         *
+         * @param marker position to rewind to
+         */
+        auto rewind(Marker const &marker) -> void;
+
+        /** Returns every chunk upstream */
+        auto release() -> void;
+
+        /** Amount of chunks currently chained */
+        [[nodiscard]] auto chunks() const noexcept -> usize;
+
+        auto alloc(usize size) -> Block;
+        auto owns(Block &block) const noexcept -> bool;
+        auto free(Block &block) -> void;
+        auto expand(Block &block, usize delta) -> bool;
+        auto reallocate(Block &block, usize new_size) -> bool;
+    };
+}  // namespace memory
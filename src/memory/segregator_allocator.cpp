@@ -0,0 +1,86 @@
+/** @file segregator_allocator.cpp */
+
+// module includes
+#include "segregator_allocator.hpp"
+
+namespace memory
+{
+    // ============================================================================================== //
+    // Dispatch ===================================================================================== //
+    // ============================================================================================== //
+
+    template <class Allocator, usize BS, usize Cap, usize... Bounds>
+    template <class Self, class F, usize... I>
+    auto inline SegregatorAllocator<Allocator, BS, Cap, Bounds...>::visit_bucket(Self &instance, usize index, F &&fn,
+                                                                                 std::index_sequence<I...> /*unused*/)
+        -> auto
+    {
+        using result_type = decltype(fn(std::get<0U>(instance.m_buckets)));
+
+        if constexpr (std::is_void_v<result_type>) {
+            (void)(((index == I) ? (fn(std::get<I>(instance.m_buckets)), true) : false) || ...);
+        } else {
+            auto result = result_type {};
+            (void)(((index == I) ? (result = fn(std::get<I>(instance.m_buckets)), true) : false) || ...);
+
+            return (result);
+        }
+    }
+
+    // ============================================================================================== //
+    // Utility methods ============================================================================== //
+    // ============================================================================================== //
+
+    template <class Allocator, usize BS, usize Cap, usize... Bounds>
+    auto inline SegregatorAllocator<Allocator, BS, Cap, Bounds...>::serves(usize size) noexcept -> bool
+    {
+        return ((size > 0U) && (size <= table::max));
+    }
+
+    template <class Allocator, usize BS, usize Cap, usize... Bounds>
+    template <usize I>
+    auto inline SegregatorAllocator<Allocator, BS, Cap, Bounds...>::get_bucket() noexcept -> bucket_type<I> &
+    {
+        return (std::get<I>(m_buckets));
+    }
+
+    // ============================================================================================== //
+    // SegregatorAllocator implementation =========================================================== //
+    // ============================================================================================== //
+
+    template <class Allocator, usize BS, usize Cap, usize... Bounds>
+    auto SegregatorAllocator<Allocator, BS, Cap, Bounds...>::alloc(usize size) -> Block
+    {
+        if (!self::serves(size)) {
+            return (null_block);
+        }
+
+        return (self::visit_bucket(
+            *this, table::index_of(size), [size](auto &bucket) -> Block { return (bucket.alloc(size)); },
+            std::make_index_sequence<table::count> {}));
+    }
+
+    template <class Allocator, usize BS, usize Cap, usize... Bounds>
+    auto SegregatorAllocator<Allocator, BS, Cap, Bounds...>::owns(Block &block) const noexcept -> bool
+    {
+        if (!self::serves(block.size)) {
+            return (false);
+        }
+
+        return (self::visit_bucket(
+            *this, table::index_of(block.size), [&block](auto const &bucket) -> bool { return (bucket.owns(block)); },
+            std::make_index_sequence<table::count> {}));
+    }
+
+    template <class Allocator, usize BS, usize Cap, usize... Bounds>
+    auto SegregatorAllocator<Allocator, BS, Cap, Bounds...>::free(Block &block) -> void
+    {
+        if (!self::serves(block.size)) {
+            return;
+        }
+
+        self::visit_bucket(
+            *this, table::index_of(block.size), [&block](auto &bucket) -> void { bucket.free(block); },
+            std::make_index_sequence<table::count> {});
+    }
+}  // namespace memory
@@ -0,0 +1,186 @@
+/** @file segregator_allocator.hpp */
+
+#pragma once
+
+// module includes
+#include "allocator_interface.hpp"
+#include "block.hpp"
+#include "free_list.hpp"
+#include "util/util.hpp"
+#include "utils.hpp"
+
+// c++ includes
+#include <array>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace memory::detail
+{
+    /**
+     * Compile-time size class table
+     *
+     * Maps a request size to the index of the smallest class able to serve it.
+     * Sizes are quantized by the greatest common divisor of all bounds, so a
+     * lookup is a single division and a table load.
+     *
+     * @tparam Bounds inclusive upper bounds of each size class, ascending
+     */
+    template <usize... Bounds>
+    struct SizeClassTable
+    {
+        usize static constexpr const count { sizeof...(Bounds) };
+        std::array<usize, count> static constexpr const bounds { Bounds... };
+
+        /** Greatest common divisor of all bounds */
+        auto static constexpr granularity() noexcept -> usize
+        {
+            auto result = usize { 0U };
+            for (auto bound : bounds) {
+                result = std::gcd(result, bound);
+            }
+
+            return (result);
+        }
+
+        /** Checks that every bound is non-zero and strictly ascending */
+        auto static constexpr is_ascending() noexcept -> bool
+        {
+            auto last = usize { 0U };
+            for (auto bound : bounds) {
+                if (bound <= last) {
+                    return (false);
+                }
+
+                last = bound;
+            }
+
+            return (true);
+        }
+
+        static_assert(count > 0U, "at least one size class is required");
+        static_assert(count <= 0xFFU, "too many size classes");
+        static_assert(is_ascending(), "size class bounds must be non-zero and ascending");
+
+        usize static constexpr const granule { granularity() };
+        usize static constexpr const max { bounds.back() };
+        usize static constexpr const slots { max / granule };
+
+        static_assert(slots <= 0x10000U, "size class table too large, use coarser bounds");
+
+        /** Generates the quantized size to class index table */
+        auto static constexpr make_lookup() noexcept -> std::array<u8, slots>
+        {
+            std::array<u8, slots> result {};
+
+            auto index = usize { 0U };
+            for (auto slot = usize { 0U }; slot < slots; ++slot) {
+                while (((slot + 1U) * granule) > bounds[index]) {
+                    ++index;
+                }
+
+                result[slot] = static_cast<u8>(index);
+            }
+
+            return (result);
+        }
+
+        std::array<u8, slots> static constexpr const lookup { make_lookup() };
+
+        /**
+         * Smallest size served by a class
+         *
+         * @param index size class index
+         * @return inclusive lower bound
+         */
+        auto static constexpr lower_bound(usize index) noexcept -> usize
+        {
+            return ((index == 0U) ? 1U : (bounds[index - 1U] + 1U));
+        }
+
+        /**
+         * Maps a size to its class, valid for `0 < size <= max`
+         *
+         * @param size requested size
+         * @return size class index
+         */
+        auto static constexpr index_of(usize size) noexcept -> usize
+        {
+            return (lookup[(size - 1U) / granule]);
+        }
+    };
+}  // namespace memory::detail
+
+namespace memory
+{
+    /**
+     * Routes each request to one of N `FreeList` buckets in constant time
+     *
+     * Bucket `i` serves sizes in `(Bounds[i - 1], Bounds[i]]`. Requests larger
+     * than the last bound yield `null_block`, so this composes with
+     * `FallbackAllocator` for the large-object path.
+     *
+     * @tparam Allocator upstream allocator of every bucket
+     * @tparam BS batch size of every bucket
+     * @tparam Cap capacity of every bucket
+     * @tparam Bounds inclusive upper bounds of each bucket, ascending
+     */
+    template <class Allocator, usize BS, usize Cap, usize... Bounds>
+    class SegregatorAllocator: private NonCopyable
+    {
+    private:
+        using self  = SegregatorAllocator<Allocator, BS, Cap, Bounds...>;
+        using table = detail::SizeClassTable<Bounds...>;
+
+        template <usize I>
+        using bucket_type = FreeList<Allocator, BS, table::lower_bound(I), table::bounds[I], Cap>;
+
+        template <class Seq>
+        struct buckets_of;
+
+        template <usize... I>
+        struct buckets_of<std::index_sequence<I...>>
+        {
+            using type = std::tuple<bucket_type<I>...>;
+        };
+
+        using buckets_type = typename buckets_of<std::make_index_sequence<table::count>>::type;
+
+        buckets_type m_buckets {};
+
+        /**
+         * Invokes `fn` on the bucket of size class `index`
+         *
+         * Unrolls into one comparison per bucket, each calling its bucket
+         * directly so the call can be inlined.
+         */
+        template <class Self, class F, usize... I>
+        auto static inline visit_bucket(Self &instance, usize index, F &&fn, std::index_sequence<I...> /*unused*/)
+            -> auto;
+
+        auto static inline serves(usize size) noexcept -> bool;
+
+    public:
+        using allocator_type = Allocator;
+
+        usize static constexpr const batch_size { BS };
+        usize static constexpr const capacity { Cap };
+        usize static constexpr const buckets { table::count };
+        usize static constexpr const max { table::max };
+
+        /**
+         * Provides access to a single bucket
+         *
+         * @tparam I index of the bucket
+         * @return reference to the bucket
+         */
+        template <usize I>
+        auto inline get_bucket() noexcept -> bucket_type<I> &;
+
+        auto alloc(usize size) -> Block;
+        auto owns(Block &block) const noexcept -> bool;
+        auto free(Block &block) -> void;
+    };
+}  // namespace memory
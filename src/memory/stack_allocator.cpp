@@ -24,8 +24,10 @@ namespace memory
     template <usize capacity, usize align>
     auto StackAllocator<capacity, align>::owns(Block &block) const noexcept -> bool
     {
-        constexpr auto from_front = (&m_buf <= block.addr);
-        constexpr auto from_back  = (block.addr <= (&m_buf + capacity));
+        auto *addr = static_cast<u8 *>(block);
+
+        auto from_front = (m_buf <= addr);
+        auto from_back  = (addr < (m_buf + capacity));
 
         return (from_front && from_back);
     }
@@ -40,4 +42,45 @@ namespace memory
             block = { nullptr, 0U };
         }
     }
+
+    template <usize capacity, usize align>
+    auto StackAllocator<capacity, align>::expand(Block &block, usize delta) -> bool
+    {
+        auto *addr = static_cast<u8 *>(block);
+
+        // only the topmost block borders free space
+        if ((addr == nullptr) || (align_front<align>(addr + block.size) != m_ptr)) {
+            return (false);
+        }
+
+        if (delta > static_cast<usize>((m_buf + capacity) - (addr + block.size))) {
+            return (false);
+        }
+
+        auto next = align_front<align>(addr + block.size + delta);
+        if (next > (m_buf + capacity)) {
+            return (false);
+        }
+
+        m_ptr = next;
+        block.size += delta;
+
+        return (true);
+    }
+
+    template <usize capacity, usize align>
+    auto StackAllocator<capacity, align>::reallocate(Block &block, usize new_size) -> bool
+    {
+        auto *addr = static_cast<u8 *>(block);
+
+        if ((addr != nullptr) && (new_size != 0U) && (new_size < block.size)
+            && (align_front<align>(addr + block.size) == m_ptr)) {
+            m_ptr      = align_front<align>(addr + new_size);
+            block.size = new_size;
+
+            return (true);
+        }
+
+        return (memory::reallocate_by_copy(*this, block, new_size));
+    }
 }  // namespace memory
@@ -12,7 +12,7 @@
 namespace memory
 {
     template <usize capacity, usize align = NO_ALIGN>
-    class StackAllocator: public AllocatorInterface
+    class StackAllocator: private NonCopyable
     {
     private:
         u8 m_buf[capacity] { 0 };
@@ -20,8 +20,10 @@ namespace memory
         u8 *m_ptr { align_front<align>(m_buf) };
 
     public:
-        auto alloc(usize size) -> Block override;
-        auto owns(Block &block) const noexcept -> bool override;
-        auto free(Block &block) -> void override;
+        auto alloc(usize size) -> Block;
+        auto owns(Block &block) const noexcept -> bool;
+        auto free(Block &block) -> void;
+        auto expand(Block &block, usize delta) -> bool;
+        auto reallocate(Block &block, usize new_size) -> bool;
     };
 }  // namespace memory
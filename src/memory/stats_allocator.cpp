@@ -0,0 +1,341 @@
+/** @file stats_allocator.cpp */
+
+// module includes
+#include "stats_allocator.hpp"
+
+// c++ includes
+#include <bit>
+
+// logging
+#include "spdlog/spdlog.h"
+
+namespace memory::detail
+{
+    /** Escapes quotes, backslashes and control characters for JSON strings */
+    auto static json_escape(std::string_view str) -> std::string
+    {
+        std::string result {};
+        result.reserve(str.size());
+
+        for (auto chr : str) {
+            switch (chr) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\t': result += "\\t"; break;
+            default: {
+                if (static_cast<u8>(chr) < 0x20U) {
+                    result += fmt::format("\\u{:04x}", static_cast<u32>(chr));
+                } else {
+                    result += chr;
+                }
+            } break;
+            }
+        }
+
+        return (result);
+    }
+}  // namespace memory::detail
+
+namespace memory
+{
+    // ============================================================================================== //
+    // Recording ==================================================================================== //
+    // ============================================================================================== //
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto inline StatsAllocator<Inner, SampleRate, SampleCount>::bucket_of(usize size) noexcept -> usize
+    {
+        // `size - 1` wraps for empty blocks
+        if (size <= 1U) {
+            return (0U);
+        }
+
+        auto bucket = static_cast<usize>(std::bit_width(size - 1U));
+
+        return (std::min(bucket, STATS_HISTOGRAM_BUCKETS - 1U));
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto inline StatsAllocator<Inner, SampleRate, SampleCount>::raise(std::atomic<usize> &peak,
+                                                                      usize value) noexcept -> void
+    {
+        auto current = peak.load(std::memory_order_relaxed);
+        while ((current < value)
+               && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::record_alloc(usize size,
+                                                                      Block const &block) noexcept -> usize
+    {
+        auto &counters = m_counters;
+
+        counters.bytes_requested.fetch_add(size, std::memory_order_relaxed);
+        counters.bytes_granted.fetch_add(block.size, std::memory_order_relaxed);
+        counters.histogram[self::bucket_of(size)].fetch_add(1U, std::memory_order_relaxed);
+
+        auto live_bytes  = counters.live_bytes.fetch_add(block.size, std::memory_order_relaxed) + block.size;
+        auto live_blocks = counters.live_blocks.fetch_add(1U, std::memory_order_relaxed) + 1U;
+
+        self::raise(counters.peak_bytes, live_bytes);
+        self::raise(counters.peak_blocks, live_blocks);
+
+        return (counters.allocs.fetch_add(1U, std::memory_order_relaxed));
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::record_free(Block const &block) noexcept -> void
+    {
+        m_counters.frees.fetch_add(1U, std::memory_order_relaxed);
+        m_counters.live_bytes.fetch_sub(block.size, std::memory_order_relaxed);
+        m_counters.live_blocks.fetch_sub(1U, std::memory_order_relaxed);
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::record_resize(usize old_size, usize new_size) noexcept
+        -> void
+    {
+        m_counters.resizes.fetch_add(1U, std::memory_order_relaxed);
+
+        if (new_size >= old_size) {
+            auto delta = new_size - old_size;
+            auto live  = m_counters.live_bytes.fetch_add(delta, std::memory_order_relaxed) + delta;
+
+            m_counters.bytes_granted.fetch_add(delta, std::memory_order_relaxed);
+            self::raise(m_counters.peak_bytes, live);
+        } else {
+            m_counters.live_bytes.fetch_sub(old_size - new_size, std::memory_order_relaxed);
+        }
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::record_sample(usize size,
+                                                                       std::source_location const &location)
+        -> void
+    {
+        std::lock_guard<std::mutex> lock { m_samples_lock };
+
+        m_samples[m_sampled % SampleCount] = AllocationSample { location, size };
+        m_sampled += 1U;
+    }
+
+    // ============================================================================================== //
+    // StatsAllocator implementation ================================================================ //
+    // ============================================================================================== //
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::alloc(usize size,
+                                                               std::source_location const &location) -> Block
+    {
+        auto block = m_allocator.alloc(size);
+        if (block == null_block) {
+            m_counters.failures.fetch_add(1U, std::memory_order_relaxed);
+            return (block);
+        }
+
+        auto ordinal = this->record_alloc(size, block);
+
+        if constexpr (SampleRate > 0U) {
+            if ((ordinal % SampleRate) == 0U) {
+                this->record_sample(size, location);
+            }
+        }
+
+        return (block);
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::alloc(usize size) -> Block
+    {
+        auto block = m_allocator.alloc(size);
+        if (block == null_block) {
+            m_counters.failures.fetch_add(1U, std::memory_order_relaxed);
+            return (block);
+        }
+
+        this->record_alloc(size, block);
+
+        return (block);
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::owns(Block &block) const noexcept -> bool
+    {
+        return (m_allocator.owns(block));
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::free(Block &block) -> void
+    {
+        if (block.addr == nullptr) {
+            return;
+        }
+
+        auto freed = block;
+
+        m_allocator.free(block);
+
+        // stack-like allocators keep blocks other than the topmost one
+        if (block.addr == nullptr) {
+            this->record_free(freed);
+        }
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::expand(Block &block, usize delta) -> bool
+    {
+        auto old_size = block.size;
+        if (!memory::expand(m_allocator, block, delta)) {
+            return (false);
+        }
+
+        this->record_resize(old_size, block.size);
+
+        return (true);
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::reallocate(Block &block, usize new_size) -> bool
+    {
+        // allocating and freeing through `reallocate` is accounted as such
+        if ((block.addr == nullptr) || (new_size == 0U)) {
+            return (memory::reallocate_by_copy(*this, block, new_size));
+        }
+
+        auto old_size = block.size;
+        if (!memory::reallocate(m_allocator, block, new_size)) {
+            m_counters.failures.fetch_add(1U, std::memory_order_relaxed);
+            return (false);
+        }
+
+        this->record_resize(old_size, block.size);
+
+        return (true);
+    }
+
+    // ============================================================================================== //
+    // Reporting ==================================================================================== //
+    // ============================================================================================== //
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto inline StatsAllocator<Inner, SampleRate, SampleCount>::get_allocator() noexcept -> Inner &
+    {
+        return (m_allocator);
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::stats() const noexcept -> AllocatorStats
+    {
+        auto const &counters = m_counters;
+
+        AllocatorStats result {
+            counters.allocs.load(std::memory_order_relaxed),
+            counters.frees.load(std::memory_order_relaxed),
+            counters.failures.load(std::memory_order_relaxed),
+            counters.resizes.load(std::memory_order_relaxed),
+            counters.bytes_requested.load(std::memory_order_relaxed),
+            counters.bytes_granted.load(std::memory_order_relaxed),
+            counters.live_bytes.load(std::memory_order_relaxed),
+            counters.peak_bytes.load(std::memory_order_relaxed),
+            counters.live_blocks.load(std::memory_order_relaxed),
+            counters.peak_blocks.load(std::memory_order_relaxed),
+            {},
+        };
+
+        for (auto i = 0U; i < STATS_HISTOGRAM_BUCKETS; ++i) {
+            result.histogram[i] = counters.histogram[i].load(std::memory_order_relaxed);
+        }
+
+        return (result);
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::samples() const -> std::vector<AllocationSample>
+    {
+        std::lock_guard<std::mutex> lock { m_samples_lock };
+
+        auto count = std::min(m_sampled, SampleCount);
+
+        std::vector<AllocationSample> result {};
+        result.reserve(count);
+
+        for (auto i = m_sampled - count; i < m_sampled; ++i) {
+            result.push_back(m_samples[i % SampleCount]);
+        }
+
+        return (result);
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::reset() noexcept -> void
+    {
+        auto &counters = m_counters;
+
+        counters.allocs.store(0U, std::memory_order_relaxed);
+        counters.frees.store(0U, std::memory_order_relaxed);
+        counters.failures.store(0U, std::memory_order_relaxed);
+        counters.resizes.store(0U, std::memory_order_relaxed);
+        counters.bytes_requested.store(0U, std::memory_order_relaxed);
+        counters.bytes_granted.store(0U, std::memory_order_relaxed);
+        counters.peak_bytes.store(counters.live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        counters.peak_blocks.store(counters.live_blocks.load(std::memory_order_relaxed),
+                                   std::memory_order_relaxed);
+
+        for (auto &bucket : counters.histogram) {
+            bucket.store(0U, std::memory_order_relaxed);
+        }
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::dump(std::string_view name) const -> void
+    {
+        auto stats = this->stats();
+
+        spdlog::info(fmt::format("MEM/STATS: '{}' allocs: {}, frees: {}, failures: {}, resizes: {}", name,
+                                 stats.allocs, stats.frees, stats.failures, stats.resizes));
+        spdlog::info(fmt::format("MEM/STATS: '{}' live: {} B in {} blocks, peak: {} B in {} blocks", name,
+                                 stats.live_bytes, stats.live_blocks, stats.peak_bytes, stats.peak_blocks));
+        spdlog::info(fmt::format("MEM/STATS: '{}' requested: {} B, granted: {} B", name, stats.bytes_requested,
+                                 stats.bytes_granted));
+
+        for (auto i = 0U; i < STATS_HISTOGRAM_BUCKETS; ++i) {
+            if (stats.histogram[i] != 0U) {
+                spdlog::info(fmt::format("MEM/STATS: '{}' <= {} B: {}", name, usize { 1U } << i,
+                                         stats.histogram[i]));
+            }
+        }
+
+        for (auto const &sample : this->samples()) {
+            spdlog::info(fmt::format("MEM/STATS: '{}' sampled {} B at {}:{} ({})", name, sample.size,
+                                     sample.location.file_name(), sample.location.line(),
+                                     sample.location.function_name()));
+        }
+    }
+
+    template <class Inner, usize SampleRate, usize SampleCount>
+    auto StatsAllocator<Inner, SampleRate, SampleCount>::to_json(std::string_view name) const -> std::string
+    {
+        auto stats = this->stats();
+
+        auto result = fmt::format(
+            R"({{"name":"{}","allocs":{},"frees":{},"failures":{},"resizes":{},"bytes_requested":{},"bytes_granted":{},)"
+            R"("live_bytes":{},"peak_bytes":{},"live_blocks":{},"peak_blocks":{},"histogram":[{}],"samples":[)",
+            detail::json_escape(name), stats.allocs, stats.frees, stats.failures, stats.resizes, stats.bytes_requested,
+            stats.bytes_granted, stats.live_bytes, stats.peak_bytes, stats.live_blocks, stats.peak_blocks,
+            fmt::join(stats.histogram, ","));
+
+        auto first = true;
+        for (auto const &sample : this->samples()) {
+            result += fmt::format(R"({}{{"file":"{}","line":{},"function":"{}","size":{}}})", first ? "" : ",",
+                                  detail::json_escape(sample.location.file_name()), sample.location.line(),
+                                  detail::json_escape(sample.location.function_name()), sample.size);
+            first = false;
+        }
+
+        result += "]}";
+
+        return (result);
+    }
+}  // namespace memory
@@ -0,0 +1,158 @@
+/** @file stats_allocator.hpp */
+
+#pragma once
+
+// module includes
+#include "allocator_interface.hpp"
+#include "block.hpp"
+#include "util/util.hpp"
+#include "utils.hpp"
+
+// c++ includes
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace memory
+{
+    /** Amount of power-of-two buckets in the size histogram, the last one catches the rest */
+    usize static constexpr const STATS_HISTOGRAM_BUCKETS = { 32U };
+
+    /** Snapshot of the counters of a `StatsAllocator` */
+    struct AllocatorStats
+    {
+        /** Successful allocations */
+        usize allocs;
+        /** Deallocations */
+        usize frees;
+        /** Allocations the inner allocator could not serve */
+        usize failures;
+        /** Blocks resized through `expand` or `reallocate` */
+        usize resizes;
+
+        /** Bytes requested by callers */
+        usize bytes_requested;
+        /** Bytes handed out by the inner allocator, the surplus is internal fragmentation */
+        usize bytes_granted;
+
+        /** Bytes currently allocated */
+        usize live_bytes;
+        /** High-water mark of `live_bytes` */
+        usize peak_bytes;
+
+        /** Blocks currently allocated */
+        usize live_blocks;
+        /** High-water mark of `live_blocks` */
+        usize peak_blocks;
+
+        /** Requested sizes, bucket `i` counts sizes in `(2^(i-1), 2^i]` */
+        std::array<usize, STATS_HISTOGRAM_BUCKETS> histogram;
+    };
+
+    /** Sampled allocation call-site */
+    struct AllocationSample
+    {
+        std::source_location location;
+        usize size;
+    };
+
+    /**
+     * Decorator recording allocation statistics of the wrapped allocator
+     *
+     * Counters are relaxed atomics, so the decorator adds no ordering to the
+     * hot path and can wrap thread-safe allocators. Every `SampleRate`-th
+     * allocation made through the `std::source_location` overload stores its
+     * call-site in a ring of `SampleCount` entries.
+     *
+     * Wrapping the upstream of a `FreeList` counts its refills, i.e. its misses.
+     *
+     * @tparam Inner wrapped allocator
+     * @tparam SampleRate sample every n-th allocation, `0` disables sampling
+     * @tparam SampleCount amount of samples kept
+     */
+    template <class Inner, usize SampleRate = 0U, usize SampleCount = 64U>
+    class StatsAllocator: private NonCopyable
+    {
+    private:
+        using self = StatsAllocator<Inner, SampleRate, SampleCount>;
+
+        /** Live counters, see `AllocatorStats` */
+        struct Counters
+        {
+            std::atomic<usize> allocs { 0U };
+            std::atomic<usize> frees { 0U };
+            std::atomic<usize> failures { 0U };
+            std::atomic<usize> resizes { 0U };
+            std::atomic<usize> bytes_requested { 0U };
+            std::atomic<usize> bytes_granted { 0U };
+            std::atomic<usize> live_bytes { 0U };
+            std::atomic<usize> peak_bytes { 0U };
+            std::atomic<usize> live_blocks { 0U };
+            std::atomic<usize> peak_blocks { 0U };
+
+            std::array<std::atomic<usize>, STATS_HISTOGRAM_BUCKETS> histogram {};
+        };
+
+        Inner m_allocator {};
+        Counters m_counters {};
+
+        mutable std::mutex m_samples_lock {};
+        std::array<AllocationSample, SampleCount> m_samples {};
+        usize m_sampled { 0U };
+
+        auto static inline bucket_of(usize size) noexcept -> usize;
+        auto static inline raise(std::atomic<usize> &peak, usize value) noexcept -> void;
+
+        auto record_alloc(usize size, Block const &block) noexcept -> usize;
+        auto record_free(Block const &block) noexcept -> void;
+        auto record_resize(usize old_size, usize new_size) noexcept -> void;
+        auto record_sample(usize size, std::source_location const &location) -> void;
+
+    public:
+        using allocator_type = Inner;
+
+        usize static constexpr const sample_rate { SampleRate };
+        usize static constexpr const sample_count { SampleCount };
+
+        /** Allocates and records the call-site when sampled */
+        auto alloc(usize size, std::source_location const &location) -> Block;
+
+        auto alloc(usize size) -> Block;
+        auto owns(Block &block) const noexcept -> bool;
+        auto free(Block &block) -> void;
+        auto expand(Block &block, usize delta) -> bool;
+        auto reallocate(Block &block, usize new_size) -> bool;
+
+        /** Provides access to the wrapped allocator */
+        auto inline get_allocator() noexcept -> Inner &;
+
+        /** Takes a snapshot of all counters */
+        [[nodiscard]] auto stats() const noexcept -> AllocatorStats;
+
+        /** Copies the sampled call-sites, oldest first */
+        [[nodiscard]] auto samples() const -> std::vector<AllocationSample>;
+
+        /** Clears all counters except the live ones */
+        auto reset() noexcept -> void;
+
+        /**
+         * Logs a summary through `spdlog`
+         *
+         * @param name name to tag the summary with
+         */
+        auto dump(std::string_view name) const -> void;
+
+        /**
+         * Serializes counters, histogram and samples as JSON
+         *
+         * @param name name to tag the object with
+         * @return JSON object
+         */
+        [[nodiscard]] auto to_json(std::string_view name) const -> std::string;
+    };
+}  // namespace memory
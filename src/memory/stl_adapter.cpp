@@ -0,0 +1,99 @@
+/** @file stl_adapter.cpp */
+
+// module includes
+#include "stl_adapter.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+// logging
+#include "spdlog/spdlog.h"
+
+namespace memory::detail
+{
+    auto report_failed_free(std::exception const &error) noexcept -> void
+    {
+        try {
+            spdlog::error(fmt::format("MEM/ERROR: Container storage could not be freed, {}", error.what()));
+        } catch (...) {
+            // nothing left to report with
+        }
+    }
+}  // namespace memory::detail
+
+namespace memory
+{
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    AllocatorResource::AllocatorResource(AllocatorInterface &allocator, usize align) noexcept
+        : m_allocator { &allocator }, m_align { align }
+    {
+    }
+
+    // ============================================================================================== //
+    // Utility methods ============================================================================== //
+    // ============================================================================================== //
+
+    auto inline AllocatorResource::padded(usize bytes, usize alignment) const noexcept -> usize
+    {
+        // blocks aligned for the request only need the header rounded up to the alignment
+        auto slack = (alignment <= m_align) ? (std::max(alignment, header) - header) : alignment;
+
+        return (bytes + header + slack);
+    }
+
+    auto AllocatorResource::get_allocator() const noexcept -> AllocatorInterface &
+    {
+        return (*m_allocator);
+    }
+
+    // ============================================================================================== //
+    // AllocatorResource implementation ============================================================= //
+    // ============================================================================================== //
+
+    auto AllocatorResource::do_allocate(usize bytes, usize alignment) -> void *
+    {
+        if (bytes > (std::numeric_limits<usize>::max() - header - alignment)) {
+            throw std::bad_array_new_length();
+        }
+
+        auto block = m_allocator->alloc(this->padded(bytes, alignment));
+        if (block.addr == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        auto base    = reinterpret_cast<uintptr>(block.addr);
+        auto aligned = (base + header + alignment - 1U) & ~(alignment - 1U);
+        auto offset  = static_cast<usize>(aligned - base);
+
+        // the header may be unaligned for `usize`
+        std::memcpy(reinterpret_cast<void *>(aligned - header), &offset, sizeof(usize));
+        std::memcpy(reinterpret_cast<void *>(aligned - sizeof(usize)), &block.size, sizeof(usize));
+
+        return (reinterpret_cast<void *>(aligned));
+    }
+
+    auto AllocatorResource::do_deallocate(void *ptr, usize /*bytes*/, usize /*alignment*/) -> void
+    {
+        auto aligned = reinterpret_cast<uintptr>(ptr);
+        auto offset  = usize { 0U };
+        auto size    = usize { 0U };
+
+        std::memcpy(&offset, reinterpret_cast<void *>(aligned - header), sizeof(usize));
+        std::memcpy(&size, reinterpret_cast<void *>(aligned - sizeof(usize)), sizeof(usize));
+
+        Block block { reinterpret_cast<void *>(aligned - offset), size };
+        m_allocator->free(block);
+    }
+
+    auto AllocatorResource::do_is_equal(std::pmr::memory_resource const &other) const noexcept -> bool
+    {
+        auto const *resource = dynamic_cast<AllocatorResource const *>(&other);
+
+        return ((resource != nullptr) && (resource->m_allocator == m_allocator));
+    }
+}  // namespace memory
@@ -0,0 +1,168 @@
+/** @file stl_adapter.hpp */
+
+#pragma once
+
+// module includes
+#include "allocator_interface.hpp"
+#include "block.hpp"
+#include "util/util.hpp"
+#include "utils.hpp"
+
+// c++ includes
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+
+namespace memory::detail
+{
+    /** Logs a free which threw out of a `noexcept` deallocation */
+    auto report_failed_free(std::exception const &error) noexcept -> void;
+}  // namespace memory::detail
+
+namespace memory
+{
+    /**
+     * Bridges an allocator to `std::allocator_traits`
+     *
+     * Holds a non-owning pointer, the allocator has to outlive every container
+     * using the adapter. Elements are only as aligned as the allocator makes
+     * them, so `Alloc` should align to at least `alignof(T)`.
+     *
+     * The size granted by the allocator is kept in front of the elements and
+     * handed back on free, allocators rounding sizes up get back what they
+     * gave out. Empty allocations never reach the allocator.
+     *
+     * @tparam T value type
+     * @tparam Alloc allocator to draw from, `AllocatorInterface` dispatches virtually
+     */
+    template <class T, class Alloc = AllocatorInterface>
+    class StlAdapter
+    {
+    private:
+        template <class U, class Other>
+        friend class StlAdapter;
+
+        Alloc *m_allocator;
+
+        /** Room for the granted size, keeping the elements aligned */
+        usize static constexpr const header { std::max(sizeof(usize), alignof(T)) };
+
+    public:
+        using value_type = T;
+        using size_type  = usize;
+
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap            = std::true_type;
+        using is_always_equal                        = std::false_type;
+
+        template <class U>
+        struct rebind
+        {
+            using other = StlAdapter<U, Alloc>;
+        };
+
+        explicit StlAdapter(Alloc &allocator) noexcept: m_allocator { &allocator }
+        {
+        }
+
+        template <class U>
+        StlAdapter(StlAdapter<U, Alloc> const &other) noexcept: m_allocator { other.m_allocator }
+        {
+        }
+
+        [[nodiscard]] auto allocate(usize count) -> T *
+        {
+            if (count == 0U) {
+                return (reinterpret_cast<T *>(alignof(T)));
+            }
+
+            if (count > ((std::numeric_limits<usize>::max() - header) / sizeof(T))) {
+                throw std::bad_array_new_length();
+            }
+
+            auto block = m_allocator->alloc(header + (count * sizeof(T)));
+            if (block.addr == nullptr) {
+                throw std::bad_alloc();
+            }
+
+            auto *data = static_cast<std::byte *>(block.addr) + header;
+            std::memcpy(data - sizeof(usize), &block.size, sizeof(usize));
+
+            return (reinterpret_cast<T *>(data));
+        }
+
+        auto deallocate(T *ptr, usize count) noexcept -> void
+        {
+            if (count == 0U) {
+                return;
+            }
+
+            auto *data = reinterpret_cast<std::byte *>(ptr);
+            auto size  = usize { 0U };
+            std::memcpy(&size, data - sizeof(usize), sizeof(usize));
+
+            try {
+                Block block { data - header, size };
+                m_allocator->free(block);
+            } catch (std::exception const &error) {
+                detail::report_failed_free(error);
+            }
+        }
+
+        /** Provides access to the underlying allocator */
+        [[nodiscard]] auto get_allocator() const noexcept -> Alloc &
+        {
+            return (*m_allocator);
+        }
+
+        template <class U>
+        auto operator==(StlAdapter<U, Alloc> const &other) const noexcept -> bool
+        {
+            return (m_allocator == other.m_allocator);
+        }
+    };
+
+    /**
+     * Exposes an allocator as a `std::pmr::memory_resource`
+     *
+     * The offset to the original block and the size the allocator granted
+     * are kept in front of the returned pointer, so alignments above `align`
+     * are served by over-allocating and frees hand back the granted size.
+     */
+    class AllocatorResource: public std::pmr::memory_resource
+    {
+    private:
+        using self = AllocatorResource;
+
+        AllocatorInterface *m_allocator;
+        usize m_align;
+
+        /** Room for the offset and the granted size */
+        usize static constexpr const header { 2U * sizeof(usize) };
+
+        /** Size of the block backing a request */
+        auto inline padded(usize bytes, usize alignment) const noexcept -> usize;
+
+    protected:
+        auto do_allocate(usize bytes, usize alignment) -> void * override;
+        auto do_deallocate(void *ptr, usize bytes, usize alignment) -> void override;
+        [[nodiscard]] auto do_is_equal(std::pmr::memory_resource const &other) const noexcept -> bool override;
+
+    public:
+        /**
+         * @param allocator allocator to draw from, has to outlive the resource
+         * @param align alignment the allocator guarantees for every block
+         */
+        explicit AllocatorResource(AllocatorInterface &allocator, usize align = WORD_ALIGN) noexcept;
+
+        /** Provides access to the underlying allocator */
+        [[nodiscard]] auto get_allocator() const noexcept -> AllocatorInterface &;
+    };
+}  // namespace memory
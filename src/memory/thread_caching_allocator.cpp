@@ -0,0 +1,267 @@
+/** @file thread_caching_allocator.cpp */
+
+// module includes
+#include "thread_caching_allocator.hpp"
+
+namespace memory::detail
+{
+    // ============================================================================================== //
+    // SpinLock implementation ====================================================================== //
+    // ============================================================================================== //
+
+    auto SpinLock::lock() noexcept -> void
+    {
+        while (m_flag.test_and_set(std::memory_order_acquire)) {
+            while (m_flag.test(std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    auto SpinLock::unlock() noexcept -> void
+    {
+        m_flag.clear(std::memory_order_release);
+    }
+
+    // ============================================================================================== //
+    // AtomicStack implementation =================================================================== //
+    // ============================================================================================== //
+
+    template <class Node>
+    auto inline AtomicStack<Node>::pack(Node *node, u64 tag) noexcept -> u64
+    {
+        return ((reinterpret_cast<uintptr>(node) & ptr_mask) | (tag << ptr_bits));
+    }
+
+    template <class Node>
+    auto inline AtomicStack<Node>::unpack(u64 head) noexcept -> Node *
+    {
+        return (reinterpret_cast<Node *>(head & ptr_mask));
+    }
+
+    template <class Node>
+    auto AtomicStack<Node>::push(Node *node) noexcept -> void
+    {
+        auto head = m_head.load(std::memory_order_relaxed);
+        auto next = u64 { 0U };
+
+        do {
+            std::atomic_ref<Node *> { node->next }.store(self::unpack(head), std::memory_order_relaxed);
+            next       = self::pack(node, (head >> ptr_bits) + 1U);
+        } while (!m_head.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    template <class Node>
+    auto AtomicStack<Node>::pop() noexcept -> Node *
+    {
+        auto head = m_head.load(std::memory_order_acquire);
+        auto next = u64 { 0U };
+
+        do {
+            if (self::unpack(head) == nullptr) {
+                return (nullptr);
+            }
+
+            // a concurrent pop may recycle the node, the tag rejects the stale `next`
+            auto *node = std::atomic_ref<Node *> { self::unpack(head)->next }.load(std::memory_order_relaxed);
+            next       = self::pack(node, (head >> ptr_bits) + 1U);
+        } while (!m_head.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire));
+
+        return (self::unpack(head));
+    }
+}  // namespace memory::detail
+
+namespace memory
+{
+    // ============================================================================================== //
+    // Ctors and Dtors ============================================================================== //
+    // ============================================================================================== //
+
+    template <class Depot, usize Threads>
+    ThreadCachingAllocator<Depot, Threads>::ThreadCachingAllocator()
+    {
+        detail::ThreadIndices::instance().subscribe(&self::on_thread_exit, this);
+    }
+
+    template <class Depot, usize Threads>
+    ThreadCachingAllocator<Depot, Threads>::~ThreadCachingAllocator()
+    {
+        detail::ThreadIndices::instance().unsubscribe(this);
+
+        for (auto &magazine : m_magazines) {
+            for (auto i = 0U; i < magazine.count; ++i) {
+                m_depot.free(magazine.blocks[i]);
+            }
+
+            magazine.count = 0U;
+        }
+
+        while (auto *full = m_full.pop()) {
+            for (auto &block : full->blocks) {
+                m_depot.free(block);
+            }
+
+            delete full;
+        }
+
+        while (auto *empty = m_empty.pop()) {
+            delete empty;
+        }
+    }
+
+    // ============================================================================================== //
+    // Utility methods ============================================================================== //
+    // ============================================================================================== //
+
+    template <class Depot, usize Threads>
+    auto inline ThreadCachingAllocator<Depot, Threads>::magazine_index() noexcept -> usize
+    {
+        return (thread_index());
+    }
+
+    template <class Depot, usize Threads>
+    auto ThreadCachingAllocator<Depot, Threads>::on_thread_exit(void *context, usize index) noexcept -> void
+    {
+        if (index >= Threads) {
+            return;
+        }
+
+        auto *instance = static_cast<self *>(context);
+        auto &magazine = instance->m_magazines[index];
+
+        // runs on the exiting thread, nobody else touches its magazine
+        instance->m_depot_lock.lock();
+        try {
+            while (magazine.count > 0U) {
+                instance->m_depot.free(magazine.blocks[--magazine.count]);
+            }
+        } catch (...) {
+            // the remaining blocks go back with the depot
+            magazine.count = 0U;
+        }
+        instance->m_depot_lock.unlock();
+    }
+
+    template <class Depot, usize Threads>
+    auto inline ThreadCachingAllocator<Depot, Threads>::acquire_batch() -> Batch *
+    {
+        auto *batch = m_empty.pop();
+        if (batch == nullptr) {
+            batch = new Batch {};
+        }
+
+        return (batch);
+    }
+
+    template <class Depot, usize Threads>
+    auto ThreadCachingAllocator<Depot, Threads>::refill(Magazine &magazine) -> bool
+    {
+        if (auto *full = m_full.pop()) {
+            std::copy(full->blocks.begin(), full->blocks.end(), magazine.blocks.begin());
+            magazine.count = batch;
+
+            m_empty.push(full);
+
+            return (true);
+        }
+
+        m_depot_lock.lock();
+        for (auto i = 0U; i < batch; ++i) {
+            auto block = m_depot.alloc(max);
+            if (block == null_block) {
+                break;
+            }
+
+            magazine.blocks[magazine.count++] = block;
+        }
+        m_depot_lock.unlock();
+
+        return (magazine.count > 0U);
+    }
+
+    template <class Depot, usize Threads>
+    auto ThreadCachingAllocator<Depot, Threads>::flush(Magazine &magazine) -> void
+    {
+        auto *full = this->acquire_batch();
+
+        magazine.count -= batch;
+
+        auto first = magazine.blocks.begin() + static_cast<isize>(magazine.count);
+        std::copy(first, first + static_cast<isize>(batch), full->blocks.begin());
+
+        m_full.push(full);
+    }
+
+    template <class Depot, usize Threads>
+    auto inline ThreadCachingAllocator<Depot, Threads>::depot_alloc() -> Block
+    {
+        m_depot_lock.lock();
+        auto block = m_depot.alloc(max);
+        m_depot_lock.unlock();
+
+        return (block);
+    }
+
+    template <class Depot, usize Threads>
+    auto inline ThreadCachingAllocator<Depot, Threads>::depot_free(Block &block) -> void
+    {
+        m_depot_lock.lock();
+        m_depot.free(block);
+        m_depot_lock.unlock();
+    }
+
+    // ============================================================================================== //
+    // ThreadCachingAllocator implementation ======================================================== //
+    // ============================================================================================== //
+
+    template <class Depot, usize Threads>
+    auto ThreadCachingAllocator<Depot, Threads>::alloc(usize size) -> Block
+    {
+        if ((size < min) || (size > max)) {
+            return (null_block);
+        }
+
+        auto index = self::magazine_index();
+        if (index >= Threads) {
+            return (this->depot_alloc());
+        }
+
+        auto &magazine = m_magazines[index];
+        if ((magazine.count == 0U) && !this->refill(magazine)) {
+            return (null_block);
+        }
+
+        return (magazine.blocks[--magazine.count]);
+    }
+
+    template <class Depot, usize Threads>
+    auto ThreadCachingAllocator<Depot, Threads>::owns(Block &block) const noexcept -> bool
+    {
+        m_depot_lock.lock();
+        auto result = m_depot.owns(block);
+        m_depot_lock.unlock();
+
+        return (result);
+    }
+
+    template <class Depot, usize Threads>
+    auto ThreadCachingAllocator<Depot, Threads>::free(Block &block) -> void
+    {
+        if ((block.size < min) || (block.size > max)) {
+            return;
+        }
+
+        auto index = self::magazine_index();
+        if (index >= Threads) {
+            this->depot_free(block);
+            return;
+        }
+
+        auto &magazine = m_magazines[index];
+        if (magazine.count == magazine.blocks.size()) {
+            this->flush(magazine);
+        }
+
+        magazine.blocks[magazine.count++] = block;
+        block                             = null_block;
+    }
+}  // namespace memory
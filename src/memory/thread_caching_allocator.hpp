@@ -0,0 +1,133 @@
+/** @file thread_caching_allocator.hpp */
+
+#pragma once
+
+// module includes
+#include "allocator_interface.hpp"
+#include "block.hpp"
+#include "util/util.hpp"
+#include "utils.hpp"
+
+// c++ includes
+#include <array>
+#include <atomic>
+
+
+namespace memory::detail
+{
+    /**
+     * Minimal spinlock guarding the upstream allocator on the slow path
+     */
+    class SpinLock final
+    {
+    private:
+        std::atomic_flag m_flag {};
+
+    public:
+        auto lock() noexcept -> void;
+        auto unlock() noexcept -> void;
+    };
+
+    /**
+     * Lock-free intrusive stack (Treiber stack)
+     *
+     * The head packs a 16-bit tag into the unused upper bits of the pointer
+     * to guard against ABA. Nodes must outlive the stack.
+     *
+     * @tparam Node intrusive node type exposing a `next` pointer
+     */
+    template <class Node>
+    class AtomicStack final
+    {
+    private:
+        using self = AtomicStack<Node>;
+
+        u64 static constexpr const ptr_bits { 48U };
+        u64 static constexpr const ptr_mask { (u64 { 1U } << ptr_bits) - 1U };
+
+        std::atomic<u64> m_head { 0U };
+
+        auto static inline pack(Node *node, u64 tag) noexcept -> u64;
+        auto static inline unpack(u64 head) noexcept -> Node *;
+
+    public:
+        auto push(Node *node) noexcept -> void;
+        auto pop() noexcept -> Node *;
+    };
+}  // namespace memory::detail
+
+namespace memory
+{
+    /**
+     * Thread-caching front-end for a `FreeList`
+     *
+     * Each thread owns a magazine of up to `2 * batch_size` blocks that is
+     * accessed without synchronization. Magazines exchange whole batches of
+     * `batch_size` blocks with a shared, lock-free depot. Only a depot miss
+     * falls through to the wrapped `FreeList`, which is guarded by a spinlock.
+     *
+     * Threads beyond `Threads` bypass the magazines and always take the slow path.
+     * Exiting threads flush their magazine into the depot and hand their index
+     * back, so short-lived threads do not use up the magazines.
+     *
+     * @tparam Depot `FreeList` used to back the depot
+     * @tparam Threads maximum amount of threads with their own magazine
+     */
+    template <class Depot, usize Threads = 64U>
+    class ThreadCachingAllocator: private NonCopyable
+    {
+    private:
+        using self = ThreadCachingAllocator<Depot, Threads>;
+
+        usize static constexpr const batch { Depot::batch_size };
+
+        /** Batch of blocks exchanged between magazines and the depot */
+        struct Batch
+        {
+            std::array<Block, batch> blocks;
+            Batch *next;
+        };
+
+        /** Per-thread block cache, padded to avoid false sharing */
+        struct alignas(CACHE_LINE_SIZE) Magazine
+        {
+            std::array<Block, batch * 2U> blocks;
+            usize count;
+        };
+
+        Depot m_depot {};
+        /** Guards the depot, `owns()` included since refills grow its slabs */
+        mutable detail::SpinLock m_depot_lock {};
+
+        detail::AtomicStack<Batch> m_full {};
+        detail::AtomicStack<Batch> m_empty {};
+
+        std::array<Magazine, Threads> m_magazines {};
+
+        auto static inline magazine_index() noexcept -> usize;
+        auto static on_thread_exit(void *context, usize index) noexcept -> void;
+
+        auto inline acquire_batch() -> Batch *;
+
+        auto refill(Magazine &magazine) -> bool;
+        auto flush(Magazine &magazine) -> void;
+
+        auto inline depot_alloc() -> Block;
+        auto inline depot_free(Block &block) -> void;
+
+    public:
+        using allocator_type = Depot;
+
+        usize static constexpr const batch_size { Depot::batch_size };
+        usize static constexpr const min { Depot::min };
+        usize static constexpr const max { Depot::max };
+        usize static constexpr const threads { Threads };
+
+        ThreadCachingAllocator();
+        ~ThreadCachingAllocator();
+
+        auto alloc(usize size) -> Block;
+        auto owns(Block &block) const noexcept -> bool;
+        auto free(Block &block) -> void;
+    };
+}  // namespace memory
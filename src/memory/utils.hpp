@@ -5,6 +5,15 @@
 // module includes
 #include "util/util.hpp"
 
+// c++ includes
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
 namespace memory
 {
     usize static constexpr const NO_ALIGN = { 1U };
@@ -21,6 +30,20 @@ namespace memory
 
     // clang-format on
 
+    /** Assumed size of a cache line, used to keep per-thread state apart */
+    usize static constexpr const CACHE_LINE_SIZE = { 64U };
+
+    /**
+     * Provides a small, dense index for the calling thread
+     *
+     * The lowest free index is handed out on first use and recycled once the
+     * thread exits, after the exit hooks of `detail::ThreadIndices` ran. From
+     * then on the thread gets `detail::THREAD_INDEX_RETIRED`.
+     *
+     * @return index of the calling thread
+     */
+    auto inline thread_index() noexcept -> usize;
+
     auto inline constexpr is_power_of_two(usize num) noexcept -> bool
     {
         while (((num & 1U) == 0U) && (num > 1U)) {
@@ -77,7 +100,7 @@ namespace memory
     {
         static_assert(is_power_of_two(align), "alignment must be power of two");
 
-        if constexpr ((size % align) == 0U) {
+        if ((size % align) == 0U) {
             return (size);
         } else {
             return (size + (align - (size % align)));
@@ -91,3 +114,152 @@ namespace memory
     }
 
 }  // namespace memory
+
+namespace memory::detail
+{
+    /** Index of a thread which has not asked for one yet */
+    usize static constexpr const THREAD_INDEX_UNSET = { ~usize { 0U } };
+    /** Index of a thread which handed its index back, past every cache's range */
+    usize static constexpr const THREAD_INDEX_RETIRED = { ~usize { 0U } - 1U };
+
+    /** Index of the calling thread, trivially destructible so it outlives every owner */
+    inline thread_local usize current_thread_index { THREAD_INDEX_UNSET };
+
+    /**
+     * Process-wide pool of thread indices
+     *
+     * Hooks subscribed by per-thread caches run on the exiting thread, before
+     * its index goes back to the pool, so they can hand back what the thread
+     * still holds. They run without the pool locked, `unsubscribe()` waits
+     * for the ones in progress.
+     */
+    class ThreadIndices final: private NonCopyable
+    {
+    public:
+        using ExitHook = void (*)(void *context, usize index) noexcept;
+
+    private:
+        struct Subscriber
+        {
+            ExitHook hook;
+            void *context;
+        };
+
+        std::mutex m_lock {};
+        std::condition_variable m_idle {};
+        std::vector<usize> m_free {};
+        std::vector<Subscriber> m_subscribers {};
+        usize m_next { 0U };
+        /** Threads running hooks right now */
+        usize m_running { 0U };
+
+    public:
+        /** Never destroyed, threads may exit after static destruction began */
+        auto static inline instance() noexcept -> ThreadIndices &
+        {
+            auto static *indices = new ThreadIndices {};
+            return (*indices);
+        }
+
+        auto inline acquire() noexcept -> usize
+        {
+            std::lock_guard<std::mutex> guard { m_lock };
+
+            if (m_free.empty()) {
+                return (m_next++);
+            }
+
+            // the lowest index keeps the thread within the caches' range
+            auto lowest = std::min_element(m_free.begin(), m_free.end());
+            auto index  = *lowest;
+
+            *lowest = m_free.back();
+            m_free.pop_back();
+
+            return (index);
+        }
+
+        auto inline release(usize index) noexcept -> void
+        {
+            std::vector<Subscriber> subscribers {};
+            {
+                std::lock_guard<std::mutex> guard { m_lock };
+
+                try {
+                    subscribers = m_subscribers;
+                } catch (std::bad_alloc const &) {
+                    // without hooks the cached blocks wait for their allocator's destruction
+                }
+
+                m_running += 1U;
+            }
+
+            // hooks may wait on locks held by threads asking for an index
+            for (auto const &subscriber : subscribers) {
+                subscriber.hook(subscriber.context, index);
+            }
+
+            {
+                std::lock_guard<std::mutex> guard { m_lock };
+
+                try {
+                    m_free.push_back(index);
+                } catch (std::bad_alloc const &) {
+                    // the index stays retired
+                }
+
+                m_running -= 1U;
+            }
+
+            m_idle.notify_all();
+        }
+
+        auto inline subscribe(ExitHook hook, void *context) -> void
+        {
+            std::lock_guard<std::mutex> guard { m_lock };
+            m_subscribers.push_back(Subscriber { hook, context });
+        }
+
+        auto inline unsubscribe(void *context) noexcept -> void
+        {
+            std::unique_lock<std::mutex> lock { m_lock };
+
+            std::erase_if(m_subscribers, [context](Subscriber const &subscriber) {
+                return (subscriber.context == context);
+            });
+
+            // a hook still running may have copied `context` before it was erased
+            m_idle.wait(lock, [this] { return (m_running == 0U); });
+        }
+    };
+
+    /** Hands the index of its thread back on thread exit */
+    class ThreadIndexOwner final: private NonCopyable
+    {
+    public:
+        ThreadIndexOwner() noexcept
+        {
+            current_thread_index = ThreadIndices::instance().acquire();
+        }
+
+        ~ThreadIndexOwner()
+        {
+            auto index = std::exchange(current_thread_index, THREAD_INDEX_RETIRED);
+
+            ThreadIndices::instance().release(index);
+        }
+    };
+}  // namespace memory::detail
+
+namespace memory
+{
+    auto inline thread_index() noexcept -> usize
+    {
+        // thread locals destroyed after the owner see the thread as retired
+        if (detail::current_thread_index == detail::THREAD_INDEX_UNSET) {
+            detail::ThreadIndexOwner thread_local const owner {};
+        }
+
+        return (detail::current_thread_index);
+    }
+}  // namespace memory
@@ -1,6 +1,7 @@
 /** @file platform_glfw.cpp */
 
 // module includes
+#include "managers/state_manager.hpp"
 #include "platform_glfw.hpp"
 #include "GLFW/glfw3.h"
 #include "bgfx/bgfx.h"
@@ -66,4 +67,10 @@ namespace platform::glfw
 
         bgfx::renderFrame();
     }
+
+    auto Window::end_frame() -> void
+    {
+        // nothing references the oldest frame anymore, recycle it
+        managers::StateManager::instance().get_frame_allocator().next_frame();
+    }
 }  // namespace platform::glfw
@@ -108,6 +108,8 @@ namespace platform
             this->render();
 
             glfwSwapBuffers(m_handle.get());
+            this->end_frame();
+
             glfwPollEvents();
         }
     }
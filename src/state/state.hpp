@@ -3,6 +3,7 @@
 #pragma once
 
 // module includes
+#include "memory/frame_allocator.hpp"
 #include "platform/platform.hpp"
 #include "util/util.hpp"
 
@@ -12,5 +13,8 @@ namespace state
     struct State
     {
         platform::Platform platform;
+
+        /** Per-frame scratch memory, rewound at the end of each frame */
+        memory::DefaultFrameAllocator frame_allocator;
     };
 }  // namespace state
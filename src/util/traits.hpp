@@ -16,13 +16,16 @@
 #include <vector>
 
 
-namespace util::traits
+// ====================================================================================================== //
+// Forward declarations in use for traits and concepts ================================================== //
+// ====================================================================================================== //
+namespace memory
 {
-    // ================================================================================================== //
-    // Forward declarations in use for traits and concepts ============================================== //
-    // ================================================================================================== //
-    class AllocatorInterface;
+    struct Block;
+}  // namespace memory
 
+namespace util::traits
+{
     // ================================================================================================== //
     // Type related traits ============================================================================== //
     // ================================================================================================== //
@@ -111,11 +114,18 @@ namespace util::traits
 
     /*******************************************************************************************************
      * Constrain `T` to an allocator
+     * Checked structurally so allocators compose without virtual dispatch
      *
      * @tparam T type to constrain
      ******************************************************************************************************/
     template <class T>
-    concept IsAllocator = std::derived_from<T, AllocatorInterface>;
+    concept IsAllocator = requires(T &allocator, T const &view, memory::Block &block, usize size) {
+        // clang-format off
+        { allocator.alloc(size)  } -> std::same_as<memory::Block>;
+        { view.owns(block)       } -> std::same_as<bool>;
+        { allocator.free(block)  } -> std::same_as<void>;
+        // clang-format on
+    };
 
     /*******************************************************************************************************
      * Constrain `T` to an STL container
@@ -0,0 +1,71 @@
+/** @file archive_builder.cpp
+ * Packs a directory of assets into an archive
+ *
+ * Usage: `archive_builder [--lz4|--zstd] <output> <directory>`. Entries are
+ * keyed by their path relative to `directory`, with forward slashes on every
+ * platform. Files which do not shrink are stored uncompressed.
+ */
+
+// module includes
+#include "assets/io/archive.hpp"
+#include "util/util.hpp"
+
+// c++ includes
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <string_view>
+
+// logging
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+
+auto main(int argc, char **argv) -> int
+{
+    auto codec = assets::io::Compression::None;
+    auto first = 1;
+
+    if (argc == 4) {
+        auto option = std::string_view { argv[1] };
+
+        if (option == "--lz4") {
+            codec = assets::io::Compression::Lz4;
+        } else if (option == "--zstd") {
+            codec = assets::io::Compression::Zstd;
+        } else {
+            argc = 0;
+        }
+
+        first = 2;
+    }
+
+    if ((argc - first) != 2) {
+        fmt::print(stderr, "usage: {} [--lz4|--zstd] <output> <directory>\n", argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    std::filesystem::path const output { argv[first] };
+    std::filesystem::path const root { argv[first + 1] };
+
+    try {
+        assets::io::ArchiveBuilder builder {};
+        builder.with_compression(codec);
+
+        for (auto const &entry : std::filesystem::recursive_directory_iterator { root }) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+
+            auto path = std::filesystem::relative(entry.path(), root).generic_string();
+            builder.add_file(path, entry.path());
+        }
+
+        builder.write(output);
+        spdlog::info(fmt::format("Packed {} assets into \'{}\'", builder.size(), output.string()));
+    } catch (std::exception const &error) {
+        spdlog::error(fmt::format("IO/ERROR: {}", error.what()));
+        return (EXIT_FAILURE);
+    }
+
+    return (EXIT_SUCCESS);
+}